@@ -0,0 +1,99 @@
+#include "baseline.h"
+#include "utils.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace kfetch {
+
+std::span<const BaselineField> baselineFields() {
+    static constexpr BaselineField fields[] = {
+        {"hostname",   FIELD_HOSTNAME, &Info::hostname},
+        {"kernel",     FIELD_KERNEL,   &Info::kernel},
+        {"distro",     FIELD_OS,       &Info::distro_name},
+        {"os",         FIELD_OS,       &Info::distro_pretty_name},
+        {"cpu",        FIELD_CPU,      &Info::cpu},
+        {"shell",      FIELD_SHELL,    &Info::shell},
+        {"packages",   FIELD_PACKAGES, &Info::packages},
+        {"gpu",        FIELD_GPU,      &Info::gpu},
+        {"gpu_driver", FIELD_GPU,      &Info::gpu_driver},
+    };
+    return fields;
+}
+
+bool loadBaseline(const std::string& path, Baseline& fields) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::string_view view = trimView(line);
+        if (view.empty() || view[0] == '#') continue;
+
+        auto eq = view.find('=');
+        if (eq == std::string_view::npos) continue;
+
+        fields.emplace_back(trimView(view.substr(0, eq)), trimView(view.substr(eq + 1)));
+    }
+
+    return true;
+}
+
+bool saveBaseline(const std::string& path, const Baseline& fields) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    file << "# kfetch baseline, compare with: kfetch --diff=" << path << "\n";
+    for (const auto& [key, value] : fields) {
+        file << key << " = " << value << "\n";
+    }
+
+    return file.good();
+}
+
+bool saveBaseline(const std::string& path, const Info& info) {
+    Baseline fields;
+    for (const auto& field : baselineFields()) {
+        fields.emplace_back(field.key, info.*field.value);
+    }
+    return saveBaseline(path, fields);
+}
+
+int diffBaseline(const std::string& path, const Config& config) {
+    Baseline expected;
+    if (!loadBaseline(path, expected)) {
+        std::cerr << "kfetch: cannot read baseline " << path << "\n";
+        return 2;
+    }
+
+    Info info;
+    int status = 0;
+
+    for (const auto& field : baselineFields()) {
+        auto it = std::find_if(expected.begin(), expected.end(),
+                               [&](const auto& kv) { return kv.first == field.key; });
+        if (it == expected.end()) continue;
+
+        collect(info, field.field);
+
+        std::string_view current = info.*field.value;
+        if (current != it->second) {
+            std::cout << field.key << ": " << it->second << " -> " << current << "\n";
+            status = 1;
+            if (!config.diff_all) return status;
+        }
+    }
+
+    for (const auto& [key, value] : expected) {
+        bool known = std::any_of(baselineFields().begin(), baselineFields().end(),
+                                 [&](const auto& field) { return key == field.key; });
+        if (!known) std::cerr << "kfetch: ignoring unknown baseline field " << key << "\n";
+    }
+
+    if (status == 0 && config.verbose_output) {
+        std::cout << "No drift from " << path << "\n";
+    }
+    return status;
+}
+
+} // namespace kfetch
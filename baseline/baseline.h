@@ -0,0 +1,41 @@
+#ifndef BASELINE_H
+#define BASELINE_H
+
+#include "libkfetch.h"
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace kfetch {
+
+// Ordered "key = value" pairs as written by --save-baseline
+using Baseline = std::vector<std::pair<std::string, std::string>>;
+
+// A field that can be saved to and compared against a baseline
+struct BaselineField {
+    const char* key;
+    Field field;               // Collector that fills it
+    std::pmr::string Info::*value;
+};
+
+// Ordered cheapest collector first, so --diff can report a mismatch
+// before the slow ones (the package database scan, lspci for the GPU) run
+std::span<const BaselineField> baselineFields();
+
+// Load a baseline file, keeping the order of the fields in it
+bool loadBaseline(const std::string& path, Baseline& fields);
+
+// Write fields as a baseline file
+bool saveBaseline(const std::string& path, const Baseline& fields);
+
+// Write the baseline fields of an already collected run
+bool saveBaseline(const std::string& path, const Info& info);
+
+// Compare the host against a baseline, collecting only the fields it lists.
+// Returns the process exit status: 0 when nothing drifted.
+int diffBaseline(const std::string& path, const Config& config);
+
+} // namespace kfetch
+
+#endif // BASELINE_H
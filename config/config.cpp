@@ -1,19 +1,14 @@
 #include "config.h"
+#include "utils.h"
+#include "kvscan.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <charconv>
 
 namespace kfetch {
 
-// Trim whitespace
-std::string trim(const std::string& s) {
-    auto first = s.find_first_not_of(" \t\n\r");
-    if (first == std::string::npos) return "";
-    auto last = s.find_last_not_of(" \t\n\r");
-    return s.substr(first, last - first + 1);
-}
-
 // Convert named color to ANSI
 std::string colorNameToCode(const std::string& colorName) {
     static const std::unordered_map<std::string, std::string> colors = {
@@ -29,27 +24,30 @@ std::string colorNameToCode(const std::string& colorName) {
     return it != colors.end() ? it->second : colorName;
 }
 
+// Store value in target if all of it is a number in [min, max]; otherwise
+// warn and keep the previous value, so a typo never aborts a run
+static void parseUnsigned(std::string_view name, std::string_view value, unsigned& target,
+                          unsigned min, unsigned max) {
+    unsigned number = 0;
+    auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (ec != std::errc() || end != value.data() + value.size() || number < min || number > max) {
+        std::cerr << "kfetch: ignoring " << name << "=" << value << " (expected " << min << "-" << max << ")\n";
+        return;
+    }
+    target = number;
+}
+
 // Load config file
 bool Config::loadFromFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    MappedFile file(path);
+    if (!file.data() && access(path.c_str(), R_OK) != 0) {
         if (verbose_output) std::cerr << "Config: Could not open " << path << "\n";
         return false;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        auto comment_pos = line.find('#');
-        if (comment_pos != std::string::npos) line = line.substr(0, comment_pos);
-        line = trim(line);
-        if (line.empty()) continue;
-
-        auto eq = line.find('=');
-        if (eq == std::string::npos) continue;
-
-        std::string key = trim(line.substr(0, eq));
-        std::string value = trim(line.substr(eq + 1));
-
+    std::string_view content(file.data(), file.size());
+    scanKeyValues(content, {.separator = '=', .comments = true},
+                  [&](std::string_view key, std::string_view value) {
         // Standard boolean flags
         if (key == "show_art") show_art = (value == "true");
         else if (key == "show_colors") show_colors = (value == "true");
@@ -64,14 +62,27 @@ bool Config::loadFromFile(const std::string& path) {
         else if (key == "show_terminal") show_terminal = (value == "true");
         else if (key == "show_cpu") show_cpu = (value == "true");
         else if (key == "show_memory") show_memory = (value == "true");
+        else if (key == "show_swap") show_swap = (value == "true");
+        else if (key == "show_numa") show_numa = (value == "true");
+        else if (key == "show_disk") show_disk = (value == "true");
+        else if (key == "show_network") show_network = (value == "true");
+        else if (key == "show_cpu_load") show_cpu_load = (value == "true");
 
         // Custom colors
-        else if (key == "custom_art_color") custom_art_color = colorNameToCode(value);
-        else if (key == "custom_text_color") custom_text_color = colorNameToCode(value);
+        else if (key == "custom_art_color") custom_art_color = colorNameToCode(std::string(value));
+        else if (key == "custom_text_color") custom_text_color = colorNameToCode(std::string(value));
+
+        else if (key == "logo_pack") logo_pack = value;
+        else if (key == "image_logo") image_logo = value;
+        else if (key == "image_protocol") image_protocol = value;
+        else if (key == "image_cols") parseUnsigned(key, value, image_cols, 1, 1000);
+        else if (key == "image_rows") parseUnsigned(key, value, image_rows, 1, 1000);
+        else if (key == "cpu_load_window") parseUnsigned(key, value, cpu_load_window, 0, 60000);
 
         // Extra user-defined options
-        else extras[key] = value;
-    }
+        else extras[std::string(key)] = value;
+        return true;
+    });
 
     return true;
 }
@@ -94,6 +105,26 @@ void Config::parseArgs(int argc, char* argv[]) {
         else if (arg == "--no-terminal") show_terminal = false;
         else if (arg == "--no-cpu") show_cpu = false;
         else if (arg == "--no-memory") show_memory = false;
+        else if (arg == "--no-swap") show_swap = false;
+        else if (arg == "--numa") show_numa = true;
+        else if (arg == "--disk") show_disk = true;
+        else if (arg == "--network") show_network = true;
+        else if (arg == "--cpu-load") show_cpu_load = true;
+        else if (arg.starts_with("--cpu-load-window=")) parseUnsigned("--cpu-load-window", arg.substr(18), cpu_load_window, 0, 60000);
+        else if (arg.starts_with("--diff=")) diff_baseline = arg.substr(7);
+        else if (arg == "--diff-all") diff_all = true;
+        else if (arg.starts_with("--save-baseline=")) save_baseline = arg.substr(16);
+        else if (arg.starts_with("--root=")) roots.push_back(arg.substr(7));
+        else if (arg.starts_with("--jobs=")) parseUnsigned("--jobs", arg.substr(7), jobs, 0, 4096);
+        else if (arg.starts_with("--prometheus=")) prometheus_path = arg.substr(13);
+        else if (arg.starts_with("--record=")) record_path = arg.substr(9);
+        else if (arg.starts_with("--interval=")) parseUnsigned("--interval", arg.substr(11), record_interval, 1, 86400);
+        else if (arg.starts_with("--replay=")) replay_path = arg.substr(9);
+        else if (arg.starts_with("--logo-pack=")) logo_pack = arg.substr(12);
+        else if (arg.starts_with("--build-logo-pack=")) build_logo_pack = arg.substr(18);
+        else if (arg == "--build-logo-pack" && i + 1 < argc) build_logo_pack = argv[++i];
+        else if (arg.starts_with("--image-logo=")) image_logo = arg.substr(13);
+        else if (arg.starts_with("--image-protocol=")) image_protocol = arg.substr(17);
     }
 }
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace kfetch {
 
@@ -21,6 +22,11 @@ struct Config {
     bool show_terminal = true;
     bool show_cpu = true;
     bool show_memory = true;
+    bool show_swap = true;
+    bool show_numa = false;     // One line per NUMA node
+    bool show_disk = false;     // One line per mounted filesystem
+    bool show_network = false;
+    bool show_cpu_load = false;  // Overall load and a per-core heat bar
 
     // Custom colors
     std::string custom_art_color = "";
@@ -29,6 +35,39 @@ struct Config {
     // Verbose output
     bool verbose_output = false;
 
+    // Drift detection (--diff, --diff-all, --save-baseline)
+    std::string diff_baseline = "";
+    bool diff_all = false;
+    std::string save_baseline = "";
+
+    // Sysroot scan (--root, repeatable, may be a glob; --jobs=N workers, which
+    // also bound the package database readers of a single run)
+    std::vector<std::string> roots;
+    unsigned jobs = 0;
+
+    // node_exporter textfile output (--prometheus=<path>)
+    std::string prometheus_path = "";
+
+    // Volatile metric history (--record=<file> --interval=<s>, --replay=<file>)
+    std::string record_path = "";
+    unsigned record_interval = 10;
+    std::string replay_path = "";
+
+    // Logo pack consulted before the built-in logos (logo_pack, --logo-pack=;
+    // empty = default path) and the directory --build-logo-pack compiles
+    std::string logo_pack = "";
+    std::string build_logo_pack = "";
+
+    // Image drawn in place of the ASCII art when the terminal supports it
+    // (image_protocol: kitty, sixel or auto), sized in character cells
+    std::string image_logo = "";
+    std::string image_protocol = "auto";
+    unsigned image_cols = 20;
+    unsigned image_rows = 10;
+
+    // Shortest span CPU load is measured over, in milliseconds
+    unsigned cpu_load_window = 200;
+
     // Any additional settings from config file
     std::unordered_map<std::string, std::string> extras;
 
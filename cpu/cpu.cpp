@@ -0,0 +1,229 @@
+#include "cpu.h"
+#include "utils.h"
+#include "procfs/procfs.h"
+#include "kvscan.h"
+#include "numfmt.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <glob.h>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <cpuid.h>
+#endif
+
+#if defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+    #define BSD_SYSTEM
+#endif
+
+namespace kfetch {
+
+// Leading number of text, 0 if none; no copy into a C string
+static uint64_t parseNumber(std::string_view text, int base = 10) {
+    if (base == 16 && (text.starts_with("0x") || text.starts_with("0X"))) text.remove_prefix(2);
+    uint64_t value = 0;
+    std::from_chars(text.data(), text.data() + text.size(), value, base);
+    return value;
+}
+
+// Frequency in a brand string's "@ 2.10GHz" suffix, in MHz
+static unsigned brandMHz(std::string_view brand) {
+    auto at = brand.find('@');
+    if (at == std::string_view::npos) return 0;
+    std::string_view number = brand.substr(at + 1);
+    while (number.starts_with(' ')) number.remove_prefix(1);
+    double ghz = 0;
+    std::from_chars(number.data(), number.data() + number.size(), ghz);
+    return brand.find("GHz", at) != std::string_view::npos ? static_cast<unsigned>(ghz * 1000 + 0.5)
+                                                             : static_cast<unsigned>(ghz + 0.5);
+}
+
+// Drop the frequency the cpufreq maximum replaces, keeping the rest of the
+// name as /proc/cpuinfo reported it: "AMD Ryzen 9 7950X 16-Core Processor"
+static std::string simplifyModel(const std::string& name) {
+    return trim(name.substr(0, name.find('@')));
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// 48-byte brand string from CPUID leaves 0x80000002-0x80000004
+static std::string cpuidBrand() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000004) return "";
+
+    char brand[49] = {};
+    for (unsigned leaf = 0; leaf < 3; leaf++) {
+        unsigned regs[4];
+        __get_cpuid(0x80000002 + leaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+        std::memcpy(brand + leaf * 16, regs, sizeof(regs));
+    }
+    return brand;
+}
+#endif
+
+#ifdef __linux__
+// Implementer and part of MIDR_EL1 as exported for each CPU
+static std::string armMidrName() {
+    char buf[64];
+    std::string_view midr = readPseudoLine("/sys/devices/system/cpu/cpu0/regs/identification/midr_el1", buf);
+    if (midr.empty()) return "";
+    uint64_t value = parseNumber(midr, 16);
+    unsigned implementer = (value >> 24) & 0xff;
+    unsigned part = (value >> 4) & 0xfff;
+
+    struct Part { unsigned implementer; unsigned part; const char* name; };
+    static constexpr Part parts[] = {
+        {0x41, 0xd03, "Cortex-A53"}, {0x41, 0xd04, "Cortex-A35"}, {0x41, 0xd05, "Cortex-A55"},
+        {0x41, 0xd07, "Cortex-A57"}, {0x41, 0xd08, "Cortex-A72"}, {0x41, 0xd09, "Cortex-A73"},
+        {0x41, 0xd0a, "Cortex-A75"}, {0x41, 0xd0b, "Cortex-A76"}, {0x41, 0xd0c, "Neoverse-N1"},
+        {0x41, 0xd0d, "Cortex-A77"}, {0x41, 0xd40, "Neoverse-V1"}, {0x41, 0xd41, "Cortex-A78"},
+        {0x41, 0xd44, "Cortex-X1"}, {0x41, 0xd46, "Cortex-A510"}, {0x41, 0xd47, "Cortex-A710"},
+        {0x41, 0xd48, "Cortex-X2"}, {0x41, 0xd49, "Neoverse-N2"}, {0x41, 0xd4d, "Cortex-A715"},
+        {0x41, 0xd4e, "Cortex-X3"}, {0x41, 0xd4f, "Neoverse-V2"}, {0x41, 0xd80, "Cortex-A520"},
+        {0x41, 0xd81, "Cortex-A720"}, {0x41, 0xd82, "Cortex-X4"}, {0x41, 0xd84, "Neoverse-V3"},
+        {0x41, 0xd8e, "Neoverse-N3"}, {0x43, 0x0af, "ThunderX2"}, {0x46, 0x001, "A64FX"},
+        {0x48, 0xd01, "Kunpeng-920"}, {0x4e, 0x004, "Carmel"}, {0x51, 0x001, "Oryon"},
+        {0xc0, 0xac3, "Ampere-1"}, {0xc0, 0xac4, "Ampere-1a"},
+    };
+    struct Vendor { unsigned implementer; const char* name; };
+    static constexpr Vendor vendors[] = {
+        {0x41, "ARM"}, {0x42, "Broadcom"}, {0x43, "Cavium"}, {0x46, "Fujitsu"},
+        {0x48, "HiSilicon"}, {0x4e, "NVIDIA"}, {0x51, "Qualcomm"}, {0x61, "Apple"},
+        {0xc0, "Ampere"},
+    };
+
+    std::string name;
+    for (const auto& vendor : vendors) {
+        if (vendor.implementer == implementer) name = vendor.name;
+    }
+    if (name.empty()) {
+        name = "ARM implementer ";
+        appendNumber(name, implementer);
+    }
+    for (const auto& known : parts) {
+        if (known.implementer == implementer && known.part == part) return name + " " + known.name;
+    }
+    char hex[16];
+    snprintf(hex, sizeof(hex), " part 0x%03x", part);
+    return name + hex;
+}
+
+// CPU numbers in a kernel cpulist such as "0-3,8-11"
+static std::vector<unsigned> parseCpuList(std::string_view list) {
+    std::vector<unsigned> cpus;
+    while (!list.empty()) {
+        auto comma = std::min(list.find(','), list.size());
+        std::string_view range = list.substr(0, comma);
+        auto dash = range.find('-');
+        unsigned first = parseNumber(range.substr(0, dash));
+        unsigned last = dash == std::string_view::npos ? first : parseNumber(range.substr(dash + 1));
+        for (unsigned cpu = first; cpu <= last && cpu < 65536; cpu++) cpus.push_back(cpu);
+        list.remove_prefix(std::min(comma + 1, list.size()));
+    }
+    return cpus;
+}
+
+// Groups among the online CPUs, reading one topology list per group
+// rather than a file per CPU: the lowest unassigned CPU's list claims
+// every CPU in its group
+static unsigned countGroups(const std::vector<unsigned>& online, const char* primary, const char* fallback) {
+    unsigned max_cpu = online.empty() ? 0 : online.back();
+    std::vector<bool> seen(max_cpu + 1, false);
+    unsigned groups = 0;
+    char path[128];
+    char buf[4096];
+    for (unsigned cpu : online) {
+        if (seen[cpu]) continue;
+        groups++;
+        seen[cpu] = true;
+        for (const char* name : {primary, fallback}) {
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/%s", cpu, name);
+            std::string_view list = readPseudoLine(path, buf);
+            if (list.empty()) continue;
+            for (unsigned sibling : parseCpuList(list)) {
+                if (sibling <= max_cpu) seen[sibling] = true;
+            }
+            break;
+        }
+    }
+    return groups;
+}
+#endif
+
+CPUInfo::CPUInfo() {
+#if defined(__x86_64__) || defined(__i386__)
+    model = cpuidBrand();
+#endif
+    max_mhz = brandMHz(model);
+
+#ifdef __linux__
+    if (model.empty()) model = armMidrName();
+    if (model.empty()) {
+        // Other architectures: the first model line of /proc/cpuinfo
+        scanKeyValues(readPseudoFile("/proc/cpuinfo"), {.separator = ':'},
+                      [&](std::string_view key, std::string_view value) {
+            if (key != "model name" && key != "Model" && key != "cpu") return true;
+            model = value;
+            return false;
+        });
+    }
+
+    char buf[4096];
+    std::vector<unsigned> online = parseCpuList(readPseudoLine("/sys/devices/system/cpu/online", buf));
+    threads = online.size();
+    if (threads > 0) {
+        sockets = countGroups(online, "package_cpus_list", "core_siblings_list");
+        cores = countGroups(online, "core_cpus_list", "thread_siblings_list");
+    }
+
+    // Highest maximum among the cpufreq policies (hybrid parts differ)
+    glob_t policies{};
+    if (glob("/sys/devices/system/cpu/cpufreq/policy*/cpuinfo_max_freq", 0, nullptr, &policies) == 0) {
+        for (size_t i = 0; i < policies.gl_pathc; i++) {
+            std::string_view khz = readPseudoLine(policies.gl_pathv[i], buf);
+            max_mhz = std::max(max_mhz, static_cast<unsigned>(parseNumber(khz) / 1000));
+        }
+    }
+    globfree(&policies);
+#elif defined(BSD_SYSTEM)
+    if (model.empty()) {
+        model = getSysctlString("hw.model");
+        max_mhz = brandMHz(model);
+    }
+    threads = getSysctlValue<int>("hw.ncpu", 0);
+#endif
+
+    model = simplifyModel(model);
+}
+
+std::string CPUInfo::getFormatted() const {
+    if (model.empty()) return "Unknown CPU";
+
+    std::string formatted = model;
+    if (threads > 0) {
+        formatted += " (";
+        if (sockets > 1) {
+            appendNumber(formatted, sockets);
+            formatted += "S/";
+        }
+        if (cores > 0) {
+            appendNumber(formatted, cores);
+            formatted += "C/";
+        }
+        appendNumber(formatted, threads);
+        formatted += "T)";
+    }
+    if (max_mhz > 0) {
+        // Up to two decimals, dropping one trailing zero: 3.7GHz, 2.45GHz
+        formatted += " @ ";
+        appendDecimal(formatted, (max_mhz + 5) / 10, 2);
+        if (formatted.ends_with('0')) formatted.pop_back();
+        formatted += "GHz";
+    }
+    return formatted;
+}
+
+} // namespace kfetch
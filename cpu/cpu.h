@@ -0,0 +1,31 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <string>
+
+namespace kfetch {
+
+class CPUInfo {
+private:
+    std::string model;
+    unsigned sockets = 0;
+    unsigned cores = 0;
+    unsigned threads = 0;
+    unsigned max_mhz = 0;
+
+public:
+    CPUInfo();
+    const std::string& getModel() const { return model; }
+    unsigned getSockets() const { return sockets; }
+    unsigned getCores() const { return cores; }
+    unsigned getThreads() const { return threads; }
+    unsigned getMaxMHz() const { return max_mhz; }
+
+    // e.g. "AMD EPYC 9654 (2S/192C/384T) @ 3.7GHz"; the socket count is
+    // left out on single-socket machines
+    std::string getFormatted() const;
+};
+
+} // namespace kfetch
+
+#endif // CPU_H
@@ -0,0 +1,161 @@
+#include "cpuload.h"
+#include "procfs/procfs.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace kfetch {
+
+// Saved state older than this says nothing about the load now
+constexpr auto MAX_STATE_AGE = std::chrono::seconds(60);
+constexpr uint32_t STATE_MAGIC = 0x4b434c31;  // "KCL1"
+
+struct StateHeader {
+    uint32_t magic;
+    uint32_t slots;
+    int64_t time_ns;  // steady_clock, which starts over at boot like the jiffies
+};
+
+// Next decimal number at p, after any spaces
+static uint64_t nextNumber(const char*& p, const char* end) {
+    while (p < end && *p == ' ') p++;
+    uint64_t value = 0;
+    for (; p < end && static_cast<unsigned>(*p - '0') < 10; p++) value = value * 10 + (*p - '0');
+    return value;
+}
+
+// Slots of the leading cpu lines of content; false if content ends
+// before the first line that is not one, as a truncated read does
+static bool parseCpuLines(std::string_view content, CpuSample& sample) {
+    sample.busy.clear();
+    sample.total.clear();
+    const char* p = content.data();
+    const char* end = p + content.size();
+    while (p < end) {
+        if (end - p < 3 || std::memcmp(p, "cpu", 3) != 0) return true;
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol) return false;
+
+        p += 3;
+        if (p < eol && *p != ' ') nextNumber(p, eol);  // "cpuN": the slot order is the CPU order
+        uint64_t fields[8] = {};  // user nice system idle iowait irq softirq steal
+        for (auto& field : fields) field = nextNumber(p, eol);
+        // guest and guest_nice are already counted in user and nice
+        uint64_t idle = fields[3] + fields[4];
+        uint64_t busy = fields[0] + fields[1] + fields[2] + fields[5] + fields[6] + fields[7];
+        sample.busy.push_back(static_cast<double>(busy));
+        sample.total.push_back(static_cast<double>(busy + idle));
+        p = eol + 1;
+    }
+    return false;
+}
+
+bool readCpuSample(CpuSample& sample) {
+    sample.time = std::chrono::steady_clock::now();
+    std::string_view content = readPseudoFile("/proc/stat");
+    // Only hosts with many hundreds of CPUs outgrow the shared 64 KiB buffer
+    thread_local std::vector<char> larger;
+    while (!parseCpuLines(content, sample) && content.size() >= std::max<size_t>(larger.size(), 64 * 1024)) {
+        larger.resize(2 * content.size());
+        content = readPseudoFile("/proc/stat", larger);
+    }
+    return !sample.busy.empty();
+}
+
+bool loadCpuSample(const std::string& path, CpuSample& sample) {
+    MappedFile file(path);
+    StateHeader header;
+    if (file.size() < sizeof(header)) return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+    size_t bytes = header.slots * sizeof(double);
+    if (header.magic != STATE_MAGIC || file.size() != sizeof(header) + 2 * bytes) return false;
+
+    sample.time = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(header.time_ns));
+    sample.busy.resize(header.slots);
+    sample.total.resize(header.slots);
+    std::memcpy(sample.busy.data(), file.data() + sizeof(header), bytes);
+    std::memcpy(sample.total.data(), file.data() + sizeof(header) + bytes, bytes);
+    return true;
+}
+
+bool saveCpuSample(const std::string& path, const CpuSample& sample) {
+    StateHeader header{STATE_MAGIC, static_cast<uint32_t>(sample.busy.size()),
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(sample.time.time_since_epoch()).count()};
+    size_t bytes = sample.busy.size() * sizeof(double);
+    std::string content(sizeof(header) + 2 * bytes, '\0');
+    std::memcpy(content.data(), &header, sizeof(header));
+    std::memcpy(content.data() + sizeof(header), sample.busy.data(), bytes);
+    std::memcpy(content.data() + sizeof(header) + bytes, sample.total.data(), bytes);
+    return writeFileAtomic(path, content);
+}
+
+// busy / total clamped to [0, 1] as a percentage; iowait may step
+// backwards, and an idle tick may not have passed
+static float busyShare(double busy, double total) {
+    double ratio = busy / (total < 1.0 ? 1.0 : total);
+    return static_cast<float>(100.0 * (ratio < 0.0 ? 0.0 : ratio > 1.0 ? 1.0 : ratio));
+}
+
+void busyPercent(const CpuSample& before, const CpuSample& after, std::span<float> percent) {
+    size_t slots = std::min({percent.size(), before.busy.size(), after.busy.size()});
+    const double* busy_before = before.busy.data();
+    const double* total_before = before.total.data();
+    const double* busy_after = after.busy.data();
+    const double* total_after = after.total.data();
+    float* out = percent.data();
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Two cores per step: subtract, divide, clamp and narrow in packed
+    // doubles (GCC leaves the clamps scalar under -ftrapping-math)
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d hundred = _mm_set1_pd(100.0);
+    for (; i + 2 <= slots; i += 2) {
+        __m128d busy = _mm_sub_pd(_mm_loadu_pd(busy_after + i), _mm_loadu_pd(busy_before + i));
+        __m128d total = _mm_sub_pd(_mm_loadu_pd(total_after + i), _mm_loadu_pd(total_before + i));
+        __m128d ratio = _mm_div_pd(busy, _mm_max_pd(total, one));
+        ratio = _mm_min_pd(_mm_max_pd(ratio, zero), one);
+        _mm_storel_pi(reinterpret_cast<__m64*>(out + i), _mm_cvtpd_ps(_mm_mul_pd(ratio, hundred)));
+    }
+#endif
+    for (; i < slots; i++) {
+        out[i] = busyShare(busy_after[i] - busy_before[i], total_after[i] - total_before[i]);
+    }
+}
+
+bool measureCpuLoad(std::chrono::milliseconds window, const std::string& state_path, std::vector<float>& percent) {
+    CpuSample before, after;
+    if (!readCpuSample(after)) return false;
+
+    // The saved sample only counts if it is recent, from this boot and
+    // from the same set of CPUs (the counters only grow)
+    bool saved = !state_path.empty() && loadCpuSample(state_path, before) &&
+                 before.busy.size() == after.busy.size() && before.time <= after.time &&
+                 after.time - before.time <= MAX_STATE_AGE && before.total[0] <= after.total[0];
+    if (!saved && window.count() > 0) {
+        before = after;
+    } else if (!saved) {
+        // Nothing to wait for: the average since boot
+        before.busy.assign(after.busy.size(), 0.0);
+        before.total.assign(after.total.size(), 0.0);
+        before.time = after.time;
+    }
+    if (after.time < before.time + window) {
+        std::this_thread::sleep_until(before.time + window);
+        if (!readCpuSample(after) || after.busy.size() != before.busy.size()) return false;
+    }
+
+    percent.resize(after.busy.size());
+    busyPercent(before, after, percent);
+    if (!state_path.empty()) saveCpuSample(state_path, after);
+    return true;
+}
+
+} // namespace kfetch
@@ -0,0 +1,42 @@
+#ifndef CPULOAD_H
+#define CPULOAD_H
+
+#include <chrono>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace kfetch {
+
+// /proc/stat jiffies as structure-of-arrays: slot 0 is the aggregate "cpu"
+// line, then one slot per online CPU, so the deltas of every core are one
+// loop over contiguous doubles (exact up to 2^53 jiffies)
+struct CpuSample {
+    std::chrono::steady_clock::time_point time;
+    std::vector<double> busy;   // user, nice, system, irq, softirq and steal
+    std::vector<double> total;  // busy plus idle and iowait
+};
+
+// Parse the cpu lines of /proc/stat in one pass over the procfs buffer,
+// reusing sample's vectors
+bool readCpuSample(CpuSample& sample);
+
+// A sample kept between runs, as raw doubles behind a small header
+bool loadCpuSample(const std::string& path, CpuSample& sample);
+bool saveCpuSample(const std::string& path, const CpuSample& sample);
+
+// Busy percent of every slot from before to after, into percent; the
+// samples must be of the same CPUs (all zero before: averages since boot)
+void busyPercent(const CpuSample& before, const CpuSample& after, std::span<float> percent);
+
+// Busy percent per slot over at least window. The starting sample is the
+// one saved at state_path when it is recent and from the same CPUs, else
+// one taken now; only what is left of the window after it is waited out,
+// so a run soon after the previous one does not wait at all. With a zero
+// window and no usable state the result is the average since boot. The
+// closing sample replaces the state (an empty state_path keeps none).
+bool measureCpuLoad(std::chrono::milliseconds window, const std::string& state_path, std::vector<float>& percent);
+
+} // namespace kfetch
+
+#endif // CPULOAD_H
@@ -0,0 +1,215 @@
+#include "disk.h"
+#include "procfs/procfs.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <sys/statvfs.h>
+
+namespace kfetch {
+
+bool isPseudoFilesystem(std::string_view fs_type) {
+    static constexpr std::string_view pseudo[] = {
+        "autofs", "binfmt_misc", "bpf", "cgroup", "cgroup2", "configfs", "debugfs", "devpts",
+        "devtmpfs", "efivarfs", "fuse.gvfsd-fuse", "fuse.lxcfs", "fuse.portal", "fusectl",
+        "hugetlbfs", "mqueue", "nfsd", "nsfs", "overlay", "proc", "pstore", "ramfs", "rpc_pipefs",
+        "securityfs", "selinuxfs", "squashfs", "sysfs", "tmpfs", "tracefs",
+    };
+    return std::ranges::find(pseudo, fs_type) != std::end(pseudo);
+}
+
+// Mounts below these are the system's plumbing (and, in containers, the
+// host's files bound in), not storage anyone means to check
+static bool isSystemPath(std::string_view mount_point) {
+    static constexpr std::string_view dirs[] = {"/proc", "/sys", "/dev", "/run", "/etc"};
+    return std::ranges::any_of(dirs, [&](std::string_view dir) {
+        return mount_point.starts_with(dir) && (mount_point.size() == dir.size() || mount_point[dir.size()] == '/');
+    });
+}
+
+// "id parent major:minor root mount_point options [optional...] - fs_type source super_options";
+// false for a malformed line
+static bool parseMountLine(std::string_view line, MountEntry& entry) {
+    std::array<std::string_view, 5> head;
+    for (auto& field : head) {
+        size_t space = line.find(' ');
+        if (space == std::string_view::npos) return false;
+        field = line.substr(0, space);
+        line.remove_prefix(space + 1);
+    }
+    // The optional fields are ended by a lone "-"
+    size_t separator = line.find(" - ");
+    if (separator == std::string_view::npos) return false;
+    line.remove_prefix(separator + 3);
+    size_t space = line.find(' ');
+    if (space == std::string_view::npos) return false;
+
+    entry.device = head[2];
+    entry.mount_point = head[4];
+    entry.fs_type = line.substr(0, space);
+    line.remove_prefix(space + 1);
+    entry.source = line.substr(0, line.find(' '));
+    return true;
+}
+
+std::vector<MountEntry> selectMounts(std::string_view mountinfo) {
+    std::vector<MountEntry> candidates;
+    std::optional<MountEntry> root;  // The last mount on "/" is the one in effect
+    while (!mountinfo.empty()) {
+        size_t eol = mountinfo.find('\n');
+        std::string_view line = mountinfo.substr(0, eol);
+        mountinfo.remove_prefix(eol == std::string_view::npos ? mountinfo.size() : eol + 1);
+
+        MountEntry entry;
+        if (!parseMountLine(line, entry)) continue;
+        if (entry.mount_point == "/") {
+            root = entry;
+        } else if (!isPseudoFilesystem(entry.fs_type) && !isSystemPath(entry.mount_point)) {
+            candidates.push_back(entry);
+        }
+    }
+
+    // A block device is known by its path, since btrfs gives each subvolume
+    // its own anonymous device number; anything else by that number
+    std::vector<MountEntry> mounts;
+    std::vector<std::string_view> seen;
+    auto keep = [&](const MountEntry& entry) {
+        std::string_view key = entry.source.starts_with("/dev/") ? entry.source : entry.device;
+        if (std::ranges::find(seen, key) != seen.end()) return;
+        seen.push_back(key);
+        mounts.push_back(entry);
+    };
+    if (root) keep(*root);
+    for (const auto& entry : candidates) keep(entry);
+    return mounts;
+}
+
+std::string unescapeMountPoint(std::string_view mount_point) {
+    auto octal = [](char c) { return c >= '0' && c <= '7'; };
+    std::string path;
+    path.reserve(mount_point.size());
+    for (size_t i = 0; i < mount_point.size(); i++) {
+        if (mount_point[i] == '\\' && i + 3 < mount_point.size() &&
+            octal(mount_point[i + 1]) && octal(mount_point[i + 2]) && octal(mount_point[i + 3])) {
+            path += static_cast<char>((mount_point[i + 1] - '0') << 6 | (mount_point[i + 2] - '0') << 3 |
+                                      (mount_point[i + 3] - '0'));
+            i += 3;
+        } else {
+            path += mount_point[i];
+        }
+    }
+    return path;
+}
+
+// Mount points whose statvfs has not returned yet, across all calls (a
+// monitor polling a hung mount would otherwise leave a thread behind on
+// every refresh). Never freed, as the threads may outlive main.
+struct InFlight {
+    std::mutex mutex;
+    std::unordered_set<std::string> mounts;
+};
+
+static InFlight& inFlight() {
+    static InFlight* in_flight = new InFlight;
+    return *in_flight;
+}
+
+std::vector<Disk> readDisks(std::chrono::milliseconds timeout) {
+    // readPseudoFile's thread-local buffer holds a few hundred mounts; a
+    // host with more (one per container) gets a larger one of its own
+    constexpr size_t SHARED_BUFFER = 64 * 1024;
+    std::string_view mountinfo = readPseudoFile("/proc/self/mountinfo");
+    std::vector<char> larger;
+    if (mountinfo.size() == SHARED_BUFFER) {
+        do {
+            larger.resize(std::max(4 * SHARED_BUFFER, 2 * larger.size()));
+            mountinfo = readPseudoFile("/proc/self/mountinfo", larger);
+        } while (mountinfo.size() == larger.size());
+    }
+    std::vector<MountEntry> mounts = selectMounts(mountinfo);
+
+    // Shared with the statvfs threads, which outlive this call when a
+    // mount hangs; each writes its own slot under the mutex
+    enum class State { PENDING, DONE, FAILED };
+    struct Probe {
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::vector<Disk> disks;
+        std::vector<State> states;
+        size_t pending = 0;
+    };
+    auto probe = std::make_shared<Probe>();
+    for (const auto& mount : mounts) {
+        Disk& disk = probe->disks.emplace_back();
+        disk.mount_point = unescapeMountPoint(mount.mount_point);
+        disk.fs_type = mount.fs_type;
+    }
+    probe->states.assign(mounts.size(), State::PENDING);
+
+    // A mount still stuck in an earlier call's probe is unresponsive now,
+    // without waiting or starting another thread on it
+    InFlight& in_flight = inFlight();
+    std::vector<size_t> started;
+    {
+        std::lock_guard lock(in_flight.mutex);
+        for (size_t i = 0; i < mounts.size(); i++) {
+            if (in_flight.mounts.insert(probe->disks[i].mount_point).second) started.push_back(i);
+        }
+    }
+    probe->pending = started.size();
+
+    for (size_t i : started) {
+        auto statMount = [probe, i, path = probe->disks[i].mount_point] {
+            struct statvfs st;
+            bool ok = statvfs(path.c_str(), &st) == 0 && st.f_blocks > 0;
+            {
+                InFlight& in_flight = inFlight();
+                std::lock_guard lock(in_flight.mutex);
+                in_flight.mounts.erase(path);
+            }
+
+            std::lock_guard lock(probe->mutex);
+            if (ok) {
+                Disk& disk = probe->disks[i];
+                disk.total_bytes = static_cast<uint64_t>(st.f_blocks) * st.f_frsize;
+                disk.used_bytes = static_cast<uint64_t>(st.f_blocks - st.f_bfree) * st.f_frsize;
+                disk.available_bytes = static_cast<uint64_t>(st.f_bavail) * st.f_frsize;
+            }
+            probe->states[i] = ok ? State::DONE : State::FAILED;
+            if (--probe->pending == 0) probe->finished.notify_one();
+        };
+
+        try {
+            std::thread(std::move(statMount)).detach();
+        } catch (const std::system_error&) {
+            // No thread to be had (EAGAIN at a container's pids.max): the
+            // mount stays PENDING, so it is reported unresponsive
+            {
+                std::lock_guard lock(in_flight.mutex);
+                in_flight.mounts.erase(probe->disks[i].mount_point);
+            }
+            std::lock_guard lock(probe->mutex);
+            probe->pending--;
+        }
+    }
+
+    std::unique_lock lock(probe->mutex);
+    probe->finished.wait_for(lock, timeout, [&] { return probe->pending == 0; });
+
+    // Mounts that cannot be read (permissions, gone) are left out
+    std::vector<Disk> disks;
+    for (size_t i = 0; i < mounts.size(); i++) {
+        if (probe->states[i] == State::FAILED) continue;
+        Disk& disk = disks.emplace_back(probe->disks[i]);
+        disk.responsive = probe->states[i] == State::DONE;
+    }
+    return disks;
+}
+
+} // namespace kfetch
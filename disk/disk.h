@@ -0,0 +1,40 @@
+#ifndef DISK_H
+#define DISK_H
+
+#include "libkfetch.h"
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kfetch {
+
+// One line of /proc/self/mountinfo, as views into the buffer it was read into
+struct MountEntry {
+    std::string_view device;       // "major:minor"
+    std::string_view mount_point;  // Still octal-escaped, e.g. "\040" for a space
+    std::string_view fs_type;
+    std::string_view source;
+};
+
+// Filesystems with no storage behind them (proc, cgroup, tmpfs, overlay, ...)
+bool isPseudoFilesystem(std::string_view fs_type);
+
+// The mounts worth a usage line, in mountinfo order with "/" first:
+// pseudo filesystems and system directories are dropped, and a device
+// mounted more than once (bind mounts, btrfs subvolumes) is kept once
+std::vector<MountEntry> selectMounts(std::string_view mountinfo);
+
+// mount_point with mountinfo's octal escapes decoded
+std::string unescapeMountPoint(std::string_view mount_point);
+
+// Usage of the selected mounts. Every statvfs runs on its own detached
+// thread, so a mount that hangs (a dead NFS server) costs at most timeout:
+// it is returned with responsive = false and its thread is left behind.
+// A mount gets no new thread while an earlier one is still stuck on it,
+// so repeated calls leave at most one thread per hung mount.
+std::vector<Disk> readDisks(std::chrono::milliseconds timeout = std::chrono::milliseconds(250));
+
+} // namespace kfetch
+
+#endif // DISK_H
@@ -1,21 +1,56 @@
 #ifndef DISTROS_H
 #define DISTROS_H
 
-#include <string>
-#include <vector>
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "width.h"
 
 namespace kfetch {
 
+constexpr size_t MAX_ART_HEIGHT = 16;
+
+// A logo as views into static data; height and display widths are filled
+// in at compile time, so nothing is built or measured when it is drawn
 struct DistroArt {
-    std::vector<std::string> art;
-    std::string color_code;
+    std::string_view id;
+    std::array<std::string_view, MAX_ART_HEIGHT> lines;
+    std::string_view color_code;
+    size_t height = 0;
+    size_t width = 0;   // Widest line, in terminal columns
+    std::array<size_t, MAX_ART_HEIGHT> line_widths{};
 };
 
+namespace detail {
+
+template <size_t N>
+constexpr std::array<DistroArt, N> measureArt(std::array<DistroArt, N> table) {
+    for (auto& entry : table) {
+        while (entry.height < MAX_ART_HEIGHT && entry.lines[entry.height].data()) entry.height++;
+        for (size_t i = 0; i < entry.height; i++) {
+            entry.line_widths[i] = displayWidth(entry.lines[i]);
+            entry.width = std::max(entry.width, entry.line_widths[i]);
+        }
+    }
+    return table;
+}
+
+// Positions of table's entries ordered by id, for binary search
+template <size_t N>
+constexpr std::array<uint8_t, N> sortArtIndex(const std::array<DistroArt, N>& table) {
+    std::array<uint8_t, N> index{};
+    for (size_t i = 0; i < N; i++) index[i] = static_cast<uint8_t>(i);
+    std::ranges::sort(index, {}, [&](uint8_t i) { return table[i].id; });
+    return index;
+}
+
+} // namespace detail
+
 // Small ASCII art logos for various distributions
-const std::unordered_map<std::string, DistroArt> distros = {
+inline constexpr auto distros = detail::measureArt(std::to_array<DistroArt>({
     {"arch", {
-        {
             "      /\\      ",
             "     /  \\     ",
             "    /\\   \\    ",
@@ -25,10 +60,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "/.\\        /.\\"
         },
         "\033[1;36m"  // Cyan
-    }},
+    },
     
     {"ubuntu", {
-        {
             "         _     ",
             "     ---(_)    ",
             " _/  ---  \\    ",
@@ -38,10 +72,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "               "
         },
         "\033[1;31m"  // Orange/Red
-    }},
+    },
     
     {"debian", {
-        {
             "  _____  ",
             " /  __ \\ ",
             "|  /    |",
@@ -51,10 +84,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "     --  "
         },
         "\033[1;31m"  // Red
-    }},
+    },
     
     {"fedora", {
-        {
             "      _____   ",
             "     /   __)  ",
             "     |  /     ",
@@ -64,10 +96,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "              "
         },
         "\033[1;34m"  // Blue
-    }},
+    },
     
     {"gentoo", {
-        {
             "   .-----.   ",
             " .`    _  `. ",
             " `.   (_)   `.",
@@ -77,10 +108,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "       \\_/    "
         },
         "\033[1;35m"  // Magenta
-    }},
+    },
     
     {"manjaro", {
-        {
             "||||||||| ||||",
             "||||||||| ||||",
             "||||      ||||",
@@ -90,10 +120,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "|||| |||| ||||"
         },
         "\033[1;32m"  // Green
-    }},
+    },
     
     {"mint", {
-        {
             " ___________  ",
             "|_          | ",
             "  | |  ___  | ",
@@ -103,10 +132,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "  |_________| "
         },
         "\033[1;32m"  // Green
-    }},
+    },
     
     {"opensuse", {
-        {
             "    _______  ",
             " .-'       `.",
             "/   \\       \\",
@@ -116,10 +144,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "              "
         },
         "\033[1;32m"  // Green
-    }},
+    },
     
     {"void", {
-        {
             "    _______   ",
             " _ \\______ -  ",
             "| \\  ___  \\ | ",
@@ -129,10 +156,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             " -_______\\    "
         },
         "\033[1;32m"  // Green
-    }},
+    },
     
     {"alpine", {
-        {
             "   /\\ /\\   ",
             "  /  \\  \\  ",
             " /    \\  \\ ",
@@ -142,10 +168,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "  \\  /  /  "
         },
         "\033[1;34m"  // Blue
-    }},
+    },
     
     {"nixos", {
-        {
             "  \\\\  \\\\ //  ",
             " ==\\\\__\\\\/ // ",
             "   //   \\\\//  ",
@@ -155,10 +180,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "  // \\\\  \\\\   "
         },
         "\033[1;36m"  // Cyan
-    }},
+    },
     
     {"pop_os", {
-        {
             "______        ",
             "\\   _ \\       ",
             " \\ \\ \\ \\      ",
@@ -168,10 +192,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "     \\_\\__\\__\\"
         },
         "\033[1;36m"  // Cyan
-    }},
+    },
     
     {"slackware", {
-        {
             "   ________  ",
             "  /  ____  \\ ",
             " /  /    \\  \\",
@@ -181,10 +204,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "  \\______\\  /"
         },
         "\033[1;35m"  // Magenta
-    }},
+    },
     
     {"freebsd", {
-        {
             "   _____    ",
             "  /     \\   ",
             " | () () |  ",
@@ -194,10 +216,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "   |   \\    "
         },
         "\033[1;31m"  // Red
-    }},
+    },
     
     {"openbsd", {
-        {
             "     _____    ",
             "   \\-     -/  ",
             "\\_/         \\ ",
@@ -207,10 +228,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "   /-_____-\\  "
         },
         "\033[1;33m"  // Yellow
-    }},
+    },
     
     {"netbsd", {
-        {
             "\\\\`-_______ ",
             " \\\\        `",
             "  \\\\      __`",
@@ -220,10 +240,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "      \\\\     "
         },
         "\033[1;31m"  // Orange/Red
-    }},
+    },
     
     {"dragonfly", {
-        {
             "    ,--,     ",
             "   |   \\     ",
             "   |    |    ",
@@ -233,10 +252,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "    `--'     "
         },
         "\033[1;32m"  // Green
-    }},
+    },
     
     {"kali", {
-        {
             " ,.;   ,.;.  ",
             ";  ';_,'  .' ",
             " \\       /   ",
@@ -246,10 +264,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             " /       \\   "
         },
         "\033[1;34m"  // Blue
-    }},
+    },
     
     {"parrot", {
-        {
             "  ____     ",
             " / __ \\    ",
             "| |  | |   ",
@@ -259,10 +276,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "  |__|     "
         },
         "\033[1;32m"  // Green
-    }},
+    },
     
     {"endeavouros", {
-        {
             "      /\\      ",
             "    //  \\\\    ",
             "   //    \\\\   ",
@@ -272,10 +288,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "\\___________//"
         },
         "\033[1;35m"  // Purple
-    }},
+    },
     
     {"artix", {
-        {
             "      /\\      ",
             "     /  \\     ",
             "    /`'.,\\    ",
@@ -285,10 +300,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "/.,'\\ `   `\\\\"
         },
         "\033[1;36m"  // Cyan
-    }},
+    },
     
     {"rocky", {
-        {
             "    _____     ",
             "   /     \\    ",
             "  | R     |   ",
@@ -298,10 +312,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "   \\_____/    "
         },
         "\033[1;32m"  // Green
-    }},
+    },
     
     {"almalinux", {
-        {
             "     /\\___/\\  ",
             "    | o   o | ",
             "    |   >   | ",
@@ -311,10 +324,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             " /_____________\\"
         },
         "\033[1;34m"  // Blue
-    }},
+    },
     
     {"centos", {
-        {
             " _____  _____ ",
             "|   _ ||_   _|",
             "|  |_| | | |  ",
@@ -324,10 +336,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "|__|_|_| |_|  "
         },
         "\033[1;35m"  // Magenta
-    }},
+    },
     
     {"rhel", {
-        {
             "     .-.-.    ",
             "    /     \\   ",
             "   | (_)   |  ",
@@ -337,10 +348,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "              "
         },
         "\033[1;31m"  // Red
-    }},
+    },
     
     {"elementary", {
-        {
             "    _____    ",
             "   /  _  \\   ",
             "  |  | |  |  ",
@@ -350,10 +360,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "             "
         },
         "\033[1;34m"  // Blue
-    }},
+    },
     
     {"solus", {
-        {
             "     /|      ",
             "    / |\\     ",
             "   /  | \\    ",
@@ -363,10 +372,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "     \\_/     "
         },
         "\033[1;34m"  // Blue
-    }},
+    },
     
     {"zorin", {
-        {
             "    ____     ",
             "   /    \\    ",
             "  | Z    |   ",
@@ -376,10 +384,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "   \\____/    "
         },
         "\033[1;36m"  // Cyan
-    }},
+    },
     
     {"mx", {
-        {
             " __  ____  __",
             "|  \\/    \\/  |",
             "| |\\  /\\  /| |",
@@ -389,10 +396,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "|_|  |__|  |_|"
         },
         "\033[1;37m"  // White
-    }},
+    },
     
     {"antergos", {
-        {
             "      /\\      ",
             "     /  \\     ",
             "    / /\\ \\    ",
@@ -402,10 +408,9 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "/_/`       `\\_\\"
         },
         "\033[1;34m"  // Blue
-    }},
+    },
     
     {"unknown", {
-        {
             "      ?       ",
             "     ???      ",
             "    ?   ?     ",
@@ -415,20 +420,29 @@ const std::unordered_map<std::string, DistroArt> distros = {
             "       ?      "
         },
         "\033[0m"  // Default
-    }}
-};
+    }
+}));
+
+inline constexpr auto distro_index = detail::sortArtIndex(distros);
+
+static_assert(distros.size() <= 256, "distro_index holds uint8_t positions");
+static_assert(std::ranges::adjacent_find(distro_index, {}, [](uint8_t i) { return distros[i].id; }) ==
+              distro_index.end(), "duplicate distro id");
 
 // Function to get distro art by name
-inline DistroArt getDistroArt(const std::string& distro_name) {
-    auto it = distros.find(distro_name);
-    if (it != distros.end()) {
-        return it->second;
+constexpr const DistroArt& getDistroArt(std::string_view distro_name) {
+    auto byId = [](uint8_t i) { return distros[i].id; };
+    auto it = std::ranges::lower_bound(distro_index, distro_name, {}, byId);
+    if (it != distro_index.end() && distros[*it].id == distro_name) {
+        return distros[*it];
     }
-    return distros.at("unknown");
+    return distros[*std::ranges::lower_bound(distro_index, "unknown", {}, byId)];
 }
 
+static_assert(getDistroArt("unknown").id == "unknown");
+
 // Reset color code
-const std::string RESET_COLOR = "\033[0m";
+inline constexpr char RESET_COLOR[] = "\033[0m";
 
 } // namespace kfetch
 
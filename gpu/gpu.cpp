@@ -1,60 +1,69 @@
 #include "gpu.h"
 #include "utils.h"
+#include "procfs/procfs.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
-#include <unordered_map>
 #include <string_view>
 #include <ranges>
+#include <climits>
+#include <unistd.h>
 
 namespace kfetch {
 
-// runCommand: execute a shell command and capture trimmed stdout
-static std::string runCommand(const char* cmd) {
-    FILE* pipe = popen(cmd, "r");
-    if (!pipe) return {};
-    char buffer[512];
-    std::string result;
-    while (fgets(buffer, sizeof(buffer), pipe))
-        result += buffer;
-    pclose(pipe);
-    return trim(result);
-}
-
 GPUInfo::GPUInfo() {
 #ifdef __linux__
     // Try lspci first
     if (system("command -v lspci >/dev/null 2>&1") == 0) {
-        std::string out = runCommand(
+        std::string out = executeCommand(
             "lspci -v | grep -A 10 'VGA\\|3D' | "
             "grep -E 'VGA|3D|NVIDIA|AMD|Intel' | head -1");
         if (!out.empty()) {
             if (auto colon = out.find(": "); colon != std::string::npos)
-                gpu_name = trim(out.substr(colon + 2));
+                gpu_name = trimView(std::string_view(out).substr(colon + 2));
             else
-                gpu_name = trim(out);
+                gpu_name = std::move(out);
         }
     }
 
     // NVIDIA-specific query fallback
     if (gpu_name.empty() &&
         system("command -v nvidia-smi >/dev/null 2>&1") == 0) {
-        gpu_name = trim(runCommand(
-            "nvidia-smi --query-gpu=name --format=csv,noheader 2>/dev/null"));
+        gpu_name = executeCommand(
+            "nvidia-smi --query-gpu=name --format=csv,noheader 2>/dev/null");
+    }
+
+    // Kernel driver bound to the first DRM card, plus its module version
+    for (int card = 0; card < 4 && driver_version.empty(); card++) {
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "/sys/class/drm/card%d/device/driver", card);
+        char target[PATH_MAX];
+        std::string_view driver = readLink(path, target);
+        if (driver.empty()) continue;
+        driver = driver.substr(driver.find_last_of('/') + 1);
+
+        snprintf(path, sizeof(path), "/sys/module/%.*s/version", static_cast<int>(driver.size()), driver.data());
+        char buf[64];
+        std::string_view version = readPseudoLine(path, buf);
+        driver_version = driver;
+        if (!version.empty()) {
+            driver_version += ' ';
+            driver_version += version;
+        }
     }
 
 #elif defined(__FreeBSD__) || defined(__DragonFly__)
     // NVIDIA query FIRST for FreeBSD
     // NVIDIA query first
     if (system("command -v nvidia-smi >/dev/null 2>&1") == 0) {
-        gpu_name = trim(runCommand(
-            "nvidia-smi --query-gpu=name --format=csv,noheader 2>/dev/null"));
+        gpu_name = executeCommand(
+            "nvidia-smi --query-gpu=name --format=csv,noheader 2>/dev/null");
     }
 
     // pciconf fallback
     if (gpu_name.empty()) {
-        std::string output = runCommand(
+        std::string output = executeCommand(
             "pciconf -lv | grep -i -A 3 -E '(vgapci|nvidia|amd|radeon|intel)'");
 
         auto extractValue = [](std::string_view line, std::string_view key) -> std::string {
@@ -72,25 +81,29 @@ GPUInfo::GPUInfo() {
                 device = extractValue(line, "device = '");
         }
 
-        if (!vendor.empty() || !device.empty())
-            gpu_name = trim(vendor + " " + device);
+        if (!vendor.empty() || !device.empty()) {
+            gpu_name = std::move(vendor);
+            gpu_name += ' ';
+            gpu_name += device;
+            collapseSpaces(gpu_name);
+        }
     }
 
     // dmesg fallback
     if (gpu_name.empty())
-        gpu_name = trim(runCommand(
-            "dmesg | grep -i -E '(nvidia|amd|radeon|intel).*graphics|vga' | head -1"));
+        gpu_name = executeCommand(
+            "dmesg | grep -i -E '(nvidia|amd|radeon|intel).*graphics|vga' | head -1");
 
     // OpenGL fallback
     if (gpu_name.empty() &&
         system("command -v glxinfo >/dev/null 2>&1") == 0) {
-        gpu_name = trim(runCommand(
-            "glxinfo 2>/dev/null | grep 'OpenGL renderer string' | cut -d: -f2"));
+        gpu_name = executeCommand(
+            "glxinfo 2>/dev/null | grep 'OpenGL renderer string' | cut -d: -f2");
     }
 
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
-    gpu_name = trim(runCommand(
-        "dmesg | grep -i 'vga\\|graphics\\|nvidia\\|amd\\|radeon' | head -1"));
+    gpu_name = executeCommand(
+        "dmesg | grep -i 'vga\\|graphics\\|nvidia\\|amd\\|radeon' | head -1");
 #endif
 
     if (gpu_name.empty())
@@ -99,48 +112,32 @@ GPUInfo::GPUInfo() {
 
 std::string GPUInfo::getFormatted() const {
     if (gpu_name == "Unknown GPU") return gpu_name;
+    return formatGpuName(gpu_name);
+}
 
-    std::string simplified = gpu_name;
+std::string formatGpuName(std::string_view name) {
+    std::string simplified(name);
 
-    // Quick string replacements
-    static const std::unordered_map<std::string_view, std::string_view> replacements = {
+    // Longer vendor names go first so "Corporation" alone only catches the rest
+    static constexpr std::pair<std::string_view, std::string_view> replacements[] = {
         {"Advanced Micro Devices", "AMD"},
         {"Intel Corporation", "Intel"},
         {"NVIDIA Corporation", "NVIDIA"},
         {"Corporation", ""},
         {"Inc.", ""}
     };
-
-    for (auto [from, to] : replacements) {
-        size_t pos = 0;
-        while ((pos = simplified.find(from, pos)) != std::string::npos) {
-            simplified.replace(pos, from.size(), std::string(to));
-            pos += to.size();
-        }
-    }
+    for (auto [from, to] : replacements) replaceAll(simplified, from, to);
 
     // Remove known prefixes
-    for (auto prefix : {"vendor ", "device "}) {
-        if (simplified.starts_with(prefix))
-            simplified.erase(0, std::char_traits<char>::length(prefix));
+    for (std::string_view prefix : {"vendor ", "device "}) {
+        if (simplified.starts_with(prefix)) simplified.erase(0, prefix.size());
     }
 
     // Remove quotes, commas, and brackets
     std::erase_if(simplified, [](char c) { return c == '\'' || c == '\"' || c == ',' || c == '[' || c == ']'; });
 
-    // Collapse multiple spaces using ranges
-    std::string result;
-    bool lastSpace = false;
-    for (char c : simplified) {
-        if (std::isspace(c)) {
-            if (!lastSpace) { result += ' '; lastSpace = true; }
-        } else {
-            result += c;
-            lastSpace = false;
-        }
-    }
-
-    return trim(result);
+    collapseSpaces(simplified);
+    return simplified;
 }
 
 } // namespace kfetch
@@ -2,6 +2,7 @@
 #define GPU_H
 
 #include <string>
+#include <string_view>
 
 namespace kfetch {
 
@@ -17,6 +18,11 @@ public:
     std::string getFormatted() const;
 };
 
+// name without vendor suffixes, lspci's field prefixes and punctuation,
+// e.g. "NVIDIA Corporation GA102 [GeForce RTX 3080]" gives
+// "NVIDIA GA102 GeForce RTX 3080"
+std::string formatGpuName(std::string_view name);
+
 } // namespace kfetch
 
 #endif // GPU_H
@@ -0,0 +1,304 @@
+#include "image.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <vector>
+
+namespace kfetch {
+
+namespace {
+
+struct Pixels {
+    unsigned width = 0;
+    unsigned height = 0;
+    std::string_view rgb;  // width * height * 3 bytes
+};
+
+// Binary PPM (P6, maxval 255), the one pixel format read without a decoder
+bool parsePpm(std::string_view data, Pixels& image) {
+    if (!data.starts_with("P6")) return false;
+    size_t pos = 2;
+    unsigned values[3];
+    for (unsigned& value : values) {
+        while (pos < data.size()) {
+            if (data[pos] == '#') pos = data.find('\n', pos);
+            else if (std::isspace(static_cast<unsigned char>(data[pos]))) pos++;
+            else break;
+        }
+        if (pos >= data.size() || !std::isdigit(static_cast<unsigned char>(data[pos]))) return false;
+        value = 0;
+        while (pos < data.size() && std::isdigit(static_cast<unsigned char>(data[pos]))) {
+            value = value * 10 + (data[pos++] - '0');
+            if (value > 65535) return false;
+        }
+    }
+    if (values[2] != 255 || pos >= data.size()) return false;
+    pos++;  // Single whitespace before the raster
+
+    image.width = values[0];
+    image.height = values[1];
+    size_t length = size_t(image.width) * image.height * 3;
+    if (length == 0 || data.size() - pos < length) return false;
+    image.rgb = data.substr(pos, length);
+    return true;
+}
+
+uint64_t fnv1a(std::string_view data) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// Cached streams kept; every resize, protocol switch or edited logo adds
+// one, so the least recently used beyond this are deleted
+constexpr size_t IMAGE_CACHE_ENTRIES = 8;
+
+void pruneImageCache(const std::string& dir) {
+    DIR* d = opendir(dir.c_str());
+    if (!d) return;
+    std::vector<std::pair<struct timespec, std::string>> entries;
+    while (struct dirent* entry = readdir(d)) {
+        struct stat st;
+        if (std::string_view(entry->d_name).starts_with("image-") &&
+            fstatat(dirfd(d), entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+            entries.emplace_back(st.st_mtim, entry->d_name);
+        }
+    }
+    closedir(d);
+    if (entries.size() <= IMAGE_CACHE_ENTRIES) return;
+
+    std::ranges::sort(entries, [](const auto& a, const auto& b) {
+        return a.first.tv_sec != b.first.tv_sec ? a.first.tv_sec > b.first.tv_sec : a.first.tv_nsec > b.first.tv_nsec;
+    });
+    for (size_t i = IMAGE_CACHE_ENTRIES; i < entries.size(); i++) unlink((dir + "/" + entries[i].second).c_str());
+}
+
+std::string base64(std::string_view data) {
+    static constexpr char digits[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 2 < data.size(); i += 3) {
+        uint32_t n = uint8_t(data[i]) << 16 | uint8_t(data[i + 1]) << 8 | uint8_t(data[i + 2]);
+        out += digits[n >> 18];
+        out += digits[n >> 12 & 63];
+        out += digits[n >> 6 & 63];
+        out += digits[n & 63];
+    }
+    if (i < data.size()) {
+        uint32_t n = uint8_t(data[i]) << 16;
+        if (i + 1 < data.size()) n |= uint8_t(data[i + 1]) << 8;
+        out += digits[n >> 18];
+        out += digits[n >> 12 & 63];
+        out += i + 1 < data.size() ? digits[n >> 6 & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+// Kitty graphics protocol: the terminal scales the image into cols x rows
+// cells itself; C=1 keeps the cursor in place and q=2 silences replies
+std::string encodeKitty(std::string_view file, bool png, const Pixels& image,
+                        unsigned cols, unsigned rows) {
+    std::string control = "a=T,q=2,C=1,c=" + std::to_string(cols) + ",r=" + std::to_string(rows);
+    if (png) {
+        control += ",f=100";
+    } else {
+        control += ",f=24,s=" + std::to_string(image.width) + ",v=" + std::to_string(image.height);
+    }
+
+    std::string payload = base64(png ? file : image.rgb);
+    std::string out;
+    constexpr size_t CHUNK = 4096;
+    for (size_t pos = 0; pos < payload.size(); pos += CHUNK) {
+        bool more = pos + CHUNK < payload.size();
+        out += "\033_G";
+        if (pos == 0) {
+            out += control;
+            out += ',';
+        }
+        out += more ? "m=1;" : "m=0;";
+        out += std::string_view(payload).substr(pos, CHUNK);
+        out += "\033\\";
+    }
+    return out;
+}
+
+// Sixel: scale to the block's pixel size (nearest neighbour), quantize to
+// a 6x6x6 color cube and emit each 6-pixel band one color at a time with
+// run-length encoding
+std::string encodeSixel(const Pixels& image, unsigned width, unsigned height) {
+    std::vector<uint8_t> index(size_t(width) * height);
+    std::array<bool, 216> used{};
+    for (unsigned y = 0; y < height; y++) {
+        unsigned sy = uint64_t(y) * image.height / height;
+        for (unsigned x = 0; x < width; x++) {
+            unsigned sx = uint64_t(x) * image.width / width;
+            const char* p = image.rgb.data() + (size_t(sy) * image.width + sx) * 3;
+            auto level = [](char c) { return (uint8_t(c) * 5 + 127) / 255; };
+            uint8_t color = level(p[0]) * 36 + level(p[1]) * 6 + level(p[2]);
+            index[size_t(y) * width + x] = color;
+            used[color] = true;
+        }
+    }
+
+    std::string out = "\033P0;1;0q\"1;1;" + std::to_string(width) + ";" + std::to_string(height);
+    for (unsigned color = 0; color < used.size(); color++) {
+        if (!used[color]) continue;
+        // Register color as RGB percentages
+        out += '#';
+        out += std::to_string(color);
+        out += ";2";
+        for (unsigned component : {color / 36, color / 6 % 6, color % 6}) {
+            out += ';';
+            out += std::to_string(component * 20);
+        }
+    }
+
+    auto emitRun = [&](char sixel, unsigned count) {
+        if (count > 3) {
+            out += '!';
+            out += std::to_string(count);
+            out += sixel;
+        } else {
+            out.append(count, sixel);
+        }
+    };
+
+    std::vector<uint8_t> bits(width);
+    for (unsigned band = 0; band < height; band += 6) {
+        std::array<bool, 216> in_band{};
+        for (unsigned y = band; y < std::min(band + 6, height); y++) {
+            for (unsigned x = 0; x < width; x++) in_band[index[size_t(y) * width + x]] = true;
+        }
+
+        bool first = true;
+        for (unsigned color = 0; color < in_band.size(); color++) {
+            if (!in_band[color]) continue;
+            std::fill(bits.begin(), bits.end(), 0);
+            for (unsigned y = band; y < std::min(band + 6, height); y++) {
+                for (unsigned x = 0; x < width; x++) {
+                    if (index[size_t(y) * width + x] == color) bits[x] |= 1u << (y - band);
+                }
+            }
+
+            if (!first) out += '$';
+            first = false;
+            out += '#';
+            out += std::to_string(color);
+            char run_char = 0;
+            unsigned run = 0;
+            for (unsigned x = 0; x < width; x++) {
+                char sixel = static_cast<char>('?' + bits[x]);
+                if (sixel == run_char) {
+                    run++;
+                    continue;
+                }
+                if (run) emitRun(run_char, run);
+                run_char = sixel;
+                run = 1;
+            }
+            emitRun(run_char, run);
+        }
+        out += '-';
+    }
+    out += "\033\\";
+    return out;
+}
+
+} // namespace
+
+ImageProtocol imageProtocol(const std::string& setting) {
+    if (setting == "kitty") return ImageProtocol::KITTY;
+    if (setting == "sixel") return ImageProtocol::SIXEL;
+    if (setting != "auto") return ImageProtocol::NONE;
+
+    auto env = [](const char* name) {
+        const char* value = std::getenv(name);
+        return std::string_view(value ? value : "");
+    };
+    std::string_view term = env("TERM");
+    std::string_view program = env("TERM_PROGRAM");
+    if (!env("KITTY_WINDOW_ID").empty() || term == "xterm-kitty" ||
+        program == "WezTerm" || program == "ghostty" || term == "xterm-ghostty") {
+        return ImageProtocol::KITTY;
+    }
+    if (term.starts_with("foot") || term.starts_with("mlterm") ||
+        term.find("sixel") != std::string_view::npos || program == "iTerm.app") {
+        return ImageProtocol::SIXEL;
+    }
+    return ImageProtocol::NONE;
+}
+
+std::string encodedImageLogo(const std::string& path, ImageProtocol protocol,
+                             unsigned cols, unsigned rows) {
+    if (protocol == ImageProtocol::NONE || cols == 0 || rows == 0) return "";
+
+    // The cache is keyed on the file's identity rather than its contents,
+    // so a hit costs a stat instead of reading and hashing the whole image
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return "";
+
+    // Sixel is drawn in pixels, so its stream also depends on the cell size
+    unsigned cell_width = 10, cell_height = 20;
+    if (protocol == ImageProtocol::SIXEL) {
+        struct winsize ws;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col && ws.ws_row &&
+            ws.ws_xpixel && ws.ws_ypixel) {
+            cell_width = ws.ws_xpixel / ws.ws_col;
+            cell_height = ws.ws_ypixel / ws.ws_row;
+        }
+    }
+
+    char key[192];
+    snprintf(key, sizeof(key), "/image-%016llx-%llx-%llx-%lld.%09ld-%s-%ux%u-%ux%u",
+             static_cast<unsigned long long>(fnv1a(path)),
+             static_cast<unsigned long long>(st.st_ino),
+             static_cast<unsigned long long>(st.st_size),
+             static_cast<long long>(st.st_mtim.tv_sec), static_cast<long>(st.st_mtim.tv_nsec),
+             protocol == ImageProtocol::KITTY ? "kitty" : "sixel",
+             cols, rows, cell_width, cell_height);
+    std::string cache_dir = cacheDirectory();
+    std::string cache_path = cache_dir.empty() ? "" : cache_dir + key;
+    if (!cache_path.empty()) {
+        MappedFile cached(cache_path);
+        if (cached.data()) {
+            // Its mtime is when it was last used, for pruneImageCache
+            utimensat(AT_FDCWD, cache_path.c_str(), nullptr, 0);
+            return std::string(cached.data(), cached.size());
+        }
+    }
+
+    MappedFile file(path);
+    if (!file.data()) return "";
+    std::string_view data(file.data(), file.size());
+    bool png = data.starts_with("\x89PNG\r\n\x1a\n");
+
+    // kfetch carries no PNG decoder and Sixel needs the pixels, so a PNG
+    // there is not drawn: the caller falls back to the ASCII logo
+    Pixels image;
+    if (!png && !parsePpm(data, image)) return "";
+    if (png && protocol == ImageProtocol::SIXEL) return "";
+
+    std::string stream = protocol == ImageProtocol::KITTY
+        ? encodeKitty(data, png, image, cols, rows)
+        : encodeSixel(image, cols * cell_width, rows * cell_height);
+    if (!cache_path.empty() && writeFileAtomic(cache_path, stream)) pruneImageCache(cache_dir);
+    return stream;
+}
+
+} // namespace kfetch
@@ -0,0 +1,24 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <string>
+
+namespace kfetch {
+
+enum class ImageProtocol { NONE, KITTY, SIXEL };
+
+// "kitty", "sixel", or "auto" to guess from the terminal's environment
+ImageProtocol imageProtocol(const std::string& setting);
+
+// Escape sequences drawing the image at path into a cols x rows cell block
+// without moving the cursor, or "" when the image cannot be shown with
+// protocol. Kitty takes PNG or binary PPM; sixel needs PPM, since kfetch
+// carries no PNG decoder. Encoding happens once: the stream is cached under
+// the image's path, inode, size and mtime, the protocol and the cell
+// geometry, and copied from there.
+std::string encodedImageLogo(const std::string& path, ImageProtocol protocol,
+                             unsigned cols, unsigned rows);
+
+} // namespace kfetch
+
+#endif // IMAGE_H
@@ -0,0 +1,102 @@
+#ifndef KVSCAN_H
+#define KVSCAN_H
+
+#include "utils.h"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace kfetch {
+
+// Line-oriented "key<separator>value" scanner for os-release, meminfo,
+// cpuinfo and the config file. It works on a buffer that is already in
+// memory and yields string_views into it, so nothing is copied per line.
+
+struct KeyValueFormat {
+    char separator = '=';
+    bool strip_quotes = false;  // os-release: KEY="value" or KEY='value'
+    bool comments = false;      // '#' starts a comment, anywhere on the line
+};
+
+// First position in [p, end) holding a or b, end if none; 16 bytes per
+// step with SSE2
+inline const char* findEither(const char* p, const char* end, char a, char b) {
+#if defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    for (; p + 16 <= end; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+#endif
+    for (; p < end; p++) {
+        if (*p == a || *p == b) return p;
+    }
+    return end;
+}
+
+// Call visit(key, value) with both trimmed for every line that has a
+// separator; lines without one are skipped. Scanning stops early when
+// visit returns false.
+template <typename Visit>
+void scanKeyValues(std::string_view text, const KeyValueFormat& format, Visit visit) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const char* hit = findEither(p, end, format.separator, '\n');
+        if (hit == end) return;
+        if (*hit == '\n') {
+            p = hit + 1;
+            continue;
+        }
+
+        const char* eol = static_cast<const char*>(std::memchr(hit, '\n', end - hit));
+        if (!eol) eol = end;
+        std::string_view key(p, hit - p);
+        std::string_view value(hit + 1, eol - hit - 1);
+        p = eol + 1;
+
+        if (format.comments) {
+            if (key.find('#') != std::string_view::npos) continue;
+            value = value.substr(0, value.find('#'));
+        }
+        key = trimView(key);
+        value = trimView(value);
+        if (format.strip_quotes && value.size() >= 2 &&
+            (value.front() == '"' || value.front() == '\'') && value.back() == value.front()) {
+            value = value.substr(1, value.size() - 2);
+        }
+        if (!visit(key, value)) return;
+    }
+}
+
+// Values of the N wanted keys (first occurrence each, empty if absent);
+// stops as soon as all of them are found. Returns how many were found.
+template <size_t N>
+size_t scanKeys(std::string_view text, const KeyValueFormat& format,
+                const std::array<std::string_view, N>& keys, std::array<std::string_view, N>& values) {
+    std::array<bool, N> found{};
+    size_t remaining = N;
+    scanKeyValues(text, format, [&](std::string_view key, std::string_view value) {
+        for (size_t i = 0; i < N; i++) {
+            if (!found[i] && key == keys[i]) {
+                found[i] = true;
+                values[i] = value;
+                remaining--;
+                break;
+            }
+        }
+        return remaining > 0;
+    });
+    return N - remaining;
+}
+
+} // namespace kfetch
+
+#endif // KVSCAN_H
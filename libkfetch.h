@@ -0,0 +1,152 @@
+#ifndef LIBKFETCH_H
+#define LIBKFETCH_H
+
+// Public API of libkfetch: collect system facts in-process and render them
+// the way the kfetch CLI does, without running the binary and parsing its output.
+
+#include "config/config.h"
+#include <cstdint>
+#include <chrono>
+#include <iosfwd>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace kfetch {
+
+// One bit per collector; a FieldMask selects what collect() runs
+enum Field : uint32_t {
+    FIELD_OS        = 1u << 0,   // distro_name, distro_pretty_name
+    FIELD_HOSTNAME  = 1u << 1,
+    FIELD_USERNAME  = 1u << 2,
+    FIELD_KERNEL    = 1u << 3,
+    FIELD_UPTIME    = 1u << 4,   // uptime, uptime_seconds
+    FIELD_PACKAGES  = 1u << 5,   // packages, package_counts
+    FIELD_SHELL     = 1u << 6,
+    FIELD_DE        = 1u << 7,
+    FIELD_TERMINAL  = 1u << 8,
+    FIELD_CPU       = 1u << 9,
+    FIELD_GPU       = 1u << 10,  // gpu, gpu_driver
+    FIELD_MEMORY    = 1u << 11,  // memory, swap and the memory_*/swap_* numbers
+    FIELD_MEMORY_NODES = 1u << 12,  // memory_nodes
+    FIELD_DISKS     = 1u << 13,  // disks
+    FIELD_NETWORK   = 1u << 14,  // network and the network_* fields
+    FIELD_CPU_LOAD  = 1u << 15,  // cpu_load_percent, core_load_percent
+    FIELD_ALL       = (1u << 16) - 1,
+};
+
+using FieldMask = uint32_t;
+
+// Fields that depend only on the files of a root filesystem
+constexpr FieldMask FIELDS_SYSROOT = FIELD_OS | FIELD_PACKAGES | FIELD_SHELL;
+
+// Memory of one NUMA node
+struct MemoryNode {
+    unsigned node = 0;
+    uint64_t used_bytes = 0;
+    uint64_t total_bytes = 0;
+};
+
+// Usage of one mounted filesystem, as df reports it
+struct Disk {
+    std::string mount_point;
+    std::string fs_type;
+    uint64_t used_bytes = 0;
+    uint64_t total_bytes = 0;
+    uint64_t available_bytes = 0;  // Free to unprivileged users
+    bool responsive = true;        // false: statvfs did not return in time, no numbers
+};
+
+// Strings and vectors take their memory from the allocator Info was built
+// with, so a caller can put a whole run in one arena. Copies use the
+// default resource, as pmr containers do.
+struct Info {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    Info() = default;
+    explicit Info(const allocator_type& alloc);
+
+    FieldMask fields = 0;   // Fields collected so far
+
+    std::pmr::string distro_name;        // os-release ID, e.g. "debian"
+    std::pmr::string distro_pretty_name; // e.g. "Debian GNU/Linux 12 (bookworm)"
+    std::pmr::string hostname;
+    std::pmr::string username;
+    std::pmr::string kernel;
+    std::pmr::string uptime;
+    std::pmr::string shell;
+    std::pmr::string desktop_env;
+    std::pmr::string terminal;
+    std::pmr::string cpu;
+    std::pmr::string gpu;
+    std::pmr::string gpu_driver;
+    std::pmr::string memory;
+    std::pmr::string swap;       // Empty without swap
+    std::pmr::string packages;
+    std::pmr::string network;    // e.g. "eth0: 192.168.1.20/24, 2001:db8::20/64 (1 Gbps)"
+
+    // Raw numbers behind the formatted strings
+    uint64_t uptime_seconds = 0;
+    uint64_t memory_used_bytes = 0;     // Total minus available, so page cache counts as free
+    uint64_t memory_total_bytes = 0;
+    uint64_t memory_available_bytes = 0;
+    uint64_t shmem_bytes = 0;
+    uint64_t hugepages_used_bytes = 0;
+    uint64_t hugepages_total_bytes = 0;
+    uint64_t swap_used_bytes = 0;
+    uint64_t swap_total_bytes = 0;
+    std::pmr::string network_interface;
+    std::pmr::string network_ipv4;  // With prefix length, empty if none
+    std::pmr::string network_ipv6;
+    unsigned network_speed_mbps = 0;  // 0 when unknown
+    float cpu_load_percent = 0;  // Busy share of all CPUs
+    std::pmr::vector<float> core_load_percent;  // Per online CPU, in CPU order
+    std::pmr::vector<MemoryNode> memory_nodes;
+    std::pmr::vector<Disk> disks;
+    std::pmr::vector<std::pair<std::pmr::string, int>> package_counts;  // {manager, count}
+};
+
+struct CollectOptions {
+    // Root filesystem the file-based collectors (FIELDS_SYSROOT) read from;
+    // empty for the host
+    std::string sysroot;
+
+    // CPU load is measured over at least this long (FIELD_CPU_LOAD)
+    std::chrono::milliseconds cpu_load_window{200};
+
+    // File the closing /proc/stat sample is kept in; the next collect()
+    // measures from it and waits only for what is left of the window.
+    // Empty to always wait the whole window.
+    std::string cpu_load_state = "";
+
+    // Threads FIELD_PACKAGES may read package databases on: 0 = one per
+    // database found, 1 = all on the calling thread
+    unsigned jobs = 0;
+};
+
+// Collect the fields in mask that info does not hold yet
+void collect(Info& info, FieldMask mask, const CollectOptions& options = {});
+
+inline Info collect(FieldMask mask = FIELD_ALL, const CollectOptions& options = {}) {
+    Info info;
+    collect(info, mask, options);
+    return info;
+}
+
+// Read the small files behind mask for many roots at once (infos[i]
+// belongs to roots[i]): one batch, through io_uring where the kernel has
+// it. Fields those files fully answer are filled in, so a collect() per
+// root afterwards only does the rest.
+void prefetch(std::span<Info> infos, std::span<const std::string> roots, FieldMask mask);
+
+// Fields render() shows for config, so nothing hidden gets collected
+FieldMask displayedFields(const Config& config);
+
+// Print info next to the distro logo, honouring config's toggles and colors
+void render(const Info& info, const Config& config, std::ostream& out);
+
+} // namespace kfetch
+
+#endif // LIBKFETCH_H
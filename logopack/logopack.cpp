@@ -0,0 +1,230 @@
+#include "logopack.h"
+#include "config/config.h"
+#include "width.h"
+#include "kvscan.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <glob.h>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace kfetch {
+
+namespace {
+
+// Layout: PackHeader, count PackEntry records sorted by id, then the
+// PackLine arrays and string data they point at. Offsets are from the start
+// of the file and in host byte order; the magic's version byte is bumped
+// on any change.
+constexpr char PACK_MAGIC[8] = {'K', 'F', 'L', 'O', 'G', 'O', 0, 2};
+
+struct PackHeader {
+    char magic[8];
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct PackEntry {
+    uint32_t id_offset;
+    uint32_t id_length;
+    uint32_t color_offset;
+    uint32_t color_length;
+    uint32_t lines_offset;  // height PackLine records
+    uint32_t height;
+    uint32_t width;   // Widest line
+    uint32_t reserved;
+};
+
+struct PackLine {
+    uint32_t offset;
+    uint32_t length;
+    uint32_t width;   // Terminal columns
+};
+
+struct SourceLogo {
+    std::string id;
+    std::string color;
+    std::vector<std::string> lines;
+};
+
+template <typename T>
+void append(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+LogoPack::LogoPack(const std::string& path) : file(path, MADV_RANDOM) {}
+
+std::optional<DistroArt> LogoPack::find(std::string_view distro_name) const {
+    const char* base = file.data();
+    size_t size = file.size();
+    if (!base || size < sizeof(PackHeader)) return std::nullopt;
+
+    PackHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 ||
+        header.count > (size - sizeof(PackHeader)) / sizeof(PackEntry)) {
+        return std::nullopt;
+    }
+
+    // Out-of-range offsets yield an empty view, so a damaged pack cannot
+    // send a lookup outside the mapping
+    auto view = [&](uint32_t offset, uint32_t length) {
+        if (offset > size || length > size - offset) return std::string_view();
+        return std::string_view(base + offset, length);
+    };
+    auto entryAt = [&](size_t i) {
+        PackEntry entry;
+        std::memcpy(&entry, base + sizeof(PackHeader) + i * sizeof(PackEntry), sizeof(entry));
+        return entry;
+    };
+
+    size_t lo = 0, hi = header.count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        PackEntry entry = entryAt(mid);
+        std::string_view id = view(entry.id_offset, entry.id_length);
+        if (id < distro_name) {
+            lo = mid + 1;
+            continue;
+        }
+        if (id > distro_name) {
+            hi = mid;
+            continue;
+        }
+
+        if (entry.height == 0 || entry.height > MAX_ART_HEIGHT ||
+            view(entry.lines_offset, entry.height * sizeof(PackLine)).empty()) {
+            return std::nullopt;
+        }
+        DistroArt art;
+        art.id = id;
+        art.color_code = view(entry.color_offset, entry.color_length);
+        art.height = entry.height;
+        art.width = entry.width;
+        for (uint32_t i = 0; i < entry.height; i++) {
+            PackLine line;
+            std::memcpy(&line, base + entry.lines_offset + i * sizeof(PackLine), sizeof(line));
+            art.lines[i] = view(line.offset, line.length);
+            art.line_widths[i] = std::min(line.width, entry.width);
+        }
+        return art;
+    }
+    return std::nullopt;
+}
+
+std::string defaultLogoPackPath() {
+    if (const char* xdg = std::getenv("XDG_DATA_HOME"); xdg && *xdg) {
+        return std::string(xdg) + "/kfetch/logos.pack";
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return std::string(home) + "/.local/share/kfetch/logos.pack";
+    }
+    return "";
+}
+
+int buildLogoPack(const std::string& dir, const std::string& pack_path) {
+    if (pack_path.empty()) {
+        std::cerr << "kfetch: no logo pack path; set --logo-pack=<file>\n";
+        return 1;
+    }
+
+    // Colors from logos.conf, in the config file's "key = value" syntax
+    std::unordered_map<std::string, std::string> colors;
+    MappedFile conf(dir + "/logos.conf");
+    scanKeyValues({conf.data(), conf.size()}, {.separator = '=', .comments = true},
+                  [&](std::string_view id, std::string_view color) {
+        colors[std::string(id)] = colorNameToCode(std::string(color));
+        return true;
+    });
+
+    std::vector<SourceLogo> logos;
+    glob_t matches{};
+    std::string pattern = dir + "/*.txt";
+    if (glob(pattern.c_str(), 0, nullptr, &matches) == 0) {
+        for (size_t i = 0; i < matches.gl_pathc; i++) {
+            std::string_view path = matches.gl_pathv[i];
+            std::string_view name = path.substr(path.rfind('/') + 1);
+
+            SourceLogo logo;
+            logo.id = name.substr(0, name.size() - 4);
+            auto color = colors.find(logo.id);
+            logo.color = color != colors.end() ? color->second : "\033[0m";
+
+            std::ifstream art{std::string(path)};
+            std::string line;
+            while (std::getline(art, line)) {
+                if (line.ends_with('\r')) line.pop_back();
+                logo.lines.push_back(line);
+            }
+            if (logo.lines.empty() || logo.lines.size() > MAX_ART_HEIGHT) {
+                std::cerr << "kfetch: " << path << ": logos must have 1 to "
+                          << MAX_ART_HEIGHT << " lines\n";
+                globfree(&matches);
+                return 1;
+            }
+            logos.push_back(std::move(logo));
+        }
+    }
+    globfree(&matches);
+    if (logos.empty()) {
+        std::cerr << "kfetch: no .txt logos in " << dir << "\n";
+        return 1;
+    }
+    std::ranges::sort(logos, {}, &SourceLogo::id);
+
+    // Index first, so lookups touch the front of the file and the logo only
+    std::string index;
+    std::string data;
+    size_t data_start = sizeof(PackHeader) + logos.size() * sizeof(PackEntry);
+    auto place = [&](std::string_view bytes) {
+        uint32_t offset = static_cast<uint32_t>(data_start + data.size());
+        data += bytes;
+        return offset;
+    };
+
+    PackHeader header{};
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.count = static_cast<uint32_t>(logos.size());
+    append(index, header);
+
+    for (const auto& logo : logos) {
+        PackEntry entry{};
+        entry.id_offset = place(logo.id);
+        entry.id_length = static_cast<uint32_t>(logo.id.size());
+        entry.color_offset = place(logo.color);
+        entry.color_length = static_cast<uint32_t>(logo.color.size());
+        entry.height = static_cast<uint32_t>(logo.lines.size());
+
+        std::vector<PackLine> lines;
+        for (const auto& art_line : logo.lines) {
+            uint32_t width = static_cast<uint32_t>(displayWidth(art_line));
+            lines.push_back({place(art_line), static_cast<uint32_t>(art_line.size()), width});
+            entry.width = std::max(entry.width, width);
+        }
+        entry.lines_offset = place({reinterpret_cast<const char*>(lines.data()),
+                                    lines.size() * sizeof(PackLine)});
+        append(index, entry);
+    }
+
+    auto slash = pack_path.rfind('/');
+    if (slash != std::string::npos && slash > 0) {
+        // Create the data directory chain for the default path
+        for (auto sep = pack_path.find('/', 1); sep != std::string::npos && sep <= slash;
+             sep = pack_path.find('/', sep + 1)) {
+            mkdir(pack_path.substr(0, sep).c_str(), 0755);
+        }
+    }
+    if (!writeFileAtomic(pack_path, index + data)) {
+        std::cerr << "kfetch: cannot write logo pack " << pack_path << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << logos.size() << " logos to " << pack_path << "\n";
+    return 0;
+}
+
+} // namespace kfetch
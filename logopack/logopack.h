@@ -0,0 +1,37 @@
+#ifndef LOGOPACK_H
+#define LOGOPACK_H
+
+#include "distros.h"
+#include "utils.h"
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace kfetch {
+
+// Site-specific logos compiled into one file by buildLogoPack(). The pack
+// starts with an index sorted by distro id that points at each logo's
+// color, line offsets and precomputed width; opening it only maps the file,
+// so a lookup faults in the index pages plus the one logo it returns.
+class LogoPack {
+private:
+    MappedFile file;
+
+public:
+    explicit LogoPack(const std::string& path);
+
+    // Logo for distro_name as views into the mapping, valid while the pack
+    // is open; nullopt when the pack is missing, corrupt or lacks the id
+    std::optional<DistroArt> find(std::string_view distro_name) const;
+};
+
+// $XDG_DATA_HOME/kfetch/logos.pack or ~/.local/share/kfetch/logos.pack
+std::string defaultLogoPackPath();
+
+// Compile <dir>/<id>.txt art files, colored by the "<id> = <color>" lines of
+// <dir>/logos.conf, into a pack at pack_path. Returns an exit code.
+int buildLogoPack(const std::string& dir, const std::string& pack_path);
+
+} // namespace kfetch
+
+#endif // LOGOPACK_H
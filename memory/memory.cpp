@@ -0,0 +1,129 @@
+#include "memory.h"
+#include "procfs/procfs.h"
+#include "kvscan.h"
+#include <charconv>
+#include <algorithm>
+#include <glob.h>
+#include <string_view>
+
+namespace kfetch {
+
+// Call handle(key, value) for each "Key:   1234 kB" line; node files
+// prefix every line with "Node <n> ", which is skipped. handle returns
+// false once it has everything it needs.
+template <typename Handler>
+static void forEachMeminfo(std::string_view content, Handler handle) {
+    scanKeyValues(content, {.separator = ':'}, [&](std::string_view key, std::string_view value) {
+        if (key.starts_with("Node ")) {
+            size_t space = key.find(' ', 5);
+            if (space == std::string_view::npos) return true;
+            key.remove_prefix(space + 1);
+        }
+        uint64_t number = 0;
+        std::from_chars(value.data(), value.data() + value.size(), number);
+        return handle(key, number);
+    });
+}
+
+bool readMeminfo(MemoryStats& stats) {
+    char buf[16384];
+    std::string_view content = readPseudoFile("/proc/meminfo", buf);
+    if (content.empty()) return false;
+
+    static constexpr std::pair<std::string_view, uint64_t MemoryStats::*> keys[] = {
+        {"MemTotal", &MemoryStats::total_kb},
+        {"MemFree", &MemoryStats::free_kb},
+        {"MemAvailable", &MemoryStats::available_kb},
+        {"Buffers", &MemoryStats::buffers_kb},
+        {"Cached", &MemoryStats::cached_kb},
+        {"SReclaimable", &MemoryStats::sreclaimable_kb},
+        {"Shmem", &MemoryStats::shmem_kb},
+        {"SwapTotal", &MemoryStats::swap_total_kb},
+        {"SwapFree", &MemoryStats::swap_free_kb},
+        {"HugePages_Total", &MemoryStats::hugepages_total},
+        {"HugePages_Free", &MemoryStats::hugepages_free},
+        {"Hugepagesize", &MemoryStats::hugepage_size_kb},
+    };
+    bool has_available = false;
+    size_t remaining = std::size(keys);
+    forEachMeminfo(content, [&](std::string_view key, uint64_t value) {
+        for (const auto& [name, member] : keys) {
+            if (key == name) {
+                stats.*member = value;
+                has_available |= member == &MemoryStats::available_kb;
+                remaining--;
+                break;
+            }
+        }
+        return remaining > 0;
+    });
+
+    if (!has_available) {
+        uint64_t reclaimable = stats.free_kb + stats.buffers_kb + stats.cached_kb + stats.sreclaimable_kb;
+        stats.available_kb = reclaimable > stats.shmem_kb ? reclaimable - stats.shmem_kb : 0;
+    }
+    stats.available_kb = std::min(stats.available_kb, stats.total_kb);
+    return stats.total_kb > 0;
+}
+
+std::vector<MemoryNode> readNodeMemory() {
+    std::vector<MemoryNode> nodes;
+    glob_t matches{};
+    if (glob("/sys/devices/system/node/node*/meminfo", 0, nullptr, &matches) != 0) {
+        globfree(&matches);
+        return nodes;
+    }
+
+    char buf[16384];
+    std::vector<uint64_t> available_kb;  // Per node, estimated
+    for (size_t i = 0; i < matches.gl_pathc; i++) {
+        // The node number sits between "node" and "/meminfo"; anything else
+        // the glob matched (say, a stray "node_x") is skipped
+        std::string_view path = matches.gl_pathv[i];
+        std::string_view number = path.substr(path.rfind("/node") + 5);
+        unsigned node_id = 0;
+        auto [end, ec] = std::from_chars(number.data(), number.data() + number.size(), node_id);
+        if (ec != std::errc() || end == number.data() || *end != '/') continue;
+
+        std::string_view content = readPseudoFile(matches.gl_pathv[i], buf);
+        if (content.empty()) continue;
+
+        // Shmem and tmpfs pages are part of FilePages but cannot be dropped
+        uint64_t total_kb = 0, free_kb = 0, file_kb = 0, shmem_kb = 0, sreclaimable_kb = 0;
+        forEachMeminfo(content, [&](std::string_view key, uint64_t value) {
+            if (key == "MemTotal") total_kb = value;
+            else if (key == "MemFree") free_kb = value;
+            else if (key == "FilePages") file_kb = value;
+            else if (key == "Shmem") shmem_kb = value;
+            else if (key == "SReclaimable") sreclaimable_kb = value;
+            return true;
+        });
+        if (total_kb == 0) continue;
+
+        MemoryNode node;
+        node.node = node_id;
+        node.total_bytes = total_kb * 1024;
+        nodes.push_back(node);
+        available_kb.push_back(std::min(total_kb, free_kb + (file_kb - std::min(file_kb, shmem_kb)) + sreclaimable_kb));
+    }
+    globfree(&matches);
+
+    // The kernel only exports MemAvailable system-wide, and it holds back
+    // watermarks and half the cache the estimate above counts as free. The
+    // nodes' available memory is scaled to add up to it, so their lines
+    // agree with the Memory line (exactly, on a single node).
+    MemoryStats stats;
+    uint64_t estimated_kb = 0;
+    for (uint64_t kb : available_kb) estimated_kb += kb;
+    double scale = readMeminfo(stats) && estimated_kb > 0 ? static_cast<double>(stats.available_kb) / estimated_kb : 1;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        uint64_t available_bytes = static_cast<uint64_t>(available_kb[i] * scale) * 1024;
+        nodes[i].used_bytes = nodes[i].total_bytes - std::min(nodes[i].total_bytes, available_bytes);
+    }
+
+    // glob sorts node10 before node2
+    std::ranges::sort(nodes, {}, &MemoryNode::node);
+    return nodes;
+}
+
+} // namespace kfetch
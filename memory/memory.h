@@ -0,0 +1,36 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include "libkfetch.h"
+#include <cstdint>
+#include <vector>
+
+namespace kfetch {
+
+// The /proc/meminfo figures kfetch reports, in kB (hugepages in pages)
+struct MemoryStats {
+    uint64_t total_kb = 0;
+    uint64_t free_kb = 0;
+    uint64_t available_kb = 0;  // Estimated from free + reclaimable cache before Linux 3.14
+    uint64_t buffers_kb = 0;
+    uint64_t cached_kb = 0;
+    uint64_t sreclaimable_kb = 0;
+    uint64_t shmem_kb = 0;
+    uint64_t swap_total_kb = 0;
+    uint64_t swap_free_kb = 0;
+    uint64_t hugepages_total = 0;
+    uint64_t hugepages_free = 0;
+    uint64_t hugepage_size_kb = 0;
+};
+
+// Parse /proc/meminfo with a single read into a stack buffer
+bool readMeminfo(MemoryStats& stats);
+
+// Used/total memory of each NUMA node from /sys/devices/system/node/node*/meminfo:
+// free, page cache other than shmem, and reclaimable slab count as available,
+// scaled so the nodes add up to the system-wide MemAvailable
+std::vector<MemoryNode> readNodeMemory();
+
+} // namespace kfetch
+
+#endif // MEMORY_H
@@ -0,0 +1,213 @@
+#include "network.h"
+#include "procfs/procfs.h"
+#include "numfmt.h"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+    #include <arpa/inet.h>
+    #include <cerrno>
+    #include <linux/netlink.h>
+    #include <linux/rtnetlink.h>
+    #include <net/if.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace kfetch {
+
+#ifdef __linux__
+
+// Ask for a dump of one rtnetlink table; body selects the address family
+template <typename Body>
+static bool requestDump(int fd, uint16_t type, uint32_t seq, const Body& body) {
+    struct {
+        nlmsghdr header;
+        Body body;
+    } request{};
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(Body));
+    request.header.nlmsg_type = type;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = seq;
+    request.body = body;
+
+    sockaddr_nl kernel{};
+    kernel.nl_family = AF_NETLINK;
+    return sendto(fd, &request, request.header.nlmsg_len, 0,
+                  reinterpret_cast<const sockaddr*>(&kernel), sizeof(kernel)) >= 0;
+}
+
+// Call visit(header) for every message of dump seq as it lands in buf;
+// false if the dump failed
+template <typename Visit>
+static bool readDump(int fd, uint32_t seq, std::span<char> buf, Visit visit) {
+    for (;;) {
+        ssize_t received = recv(fd, buf.data(), buf.size(), 0);
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        unsigned length = static_cast<unsigned>(received);
+        for (auto* header = reinterpret_cast<const nlmsghdr*>(buf.data()); NLMSG_OK(header, length);
+             header = NLMSG_NEXT(header, length)) {
+            if (header->nlmsg_seq != seq) continue;
+            if (header->nlmsg_type == NLMSG_DONE) return true;
+            if (header->nlmsg_type == NLMSG_ERROR) return false;
+            visit(header);
+        }
+    }
+}
+
+// Call visit(type, payload) for each attribute in [first, first + length)
+template <typename Visit>
+static void forEachAttribute(const rtattr* attribute, unsigned length, Visit visit) {
+    for (; RTA_OK(attribute, length); attribute = RTA_NEXT(attribute, length)) {
+        visit(attribute->rta_type, std::span<const char>(static_cast<const char*>(RTA_DATA(attribute)),
+                                                         RTA_PAYLOAD(attribute)));
+    }
+}
+
+template <typename T>
+static T attributeValue(std::span<const char> payload) {
+    T value{};
+    if (payload.size() >= sizeof(T)) std::memcpy(&value, payload.data(), sizeof(T));
+    return value;
+}
+
+// Interface index of the main table's default route: IPv4 before IPv6,
+// then the lowest metric; 0 when there is none
+static int defaultRouteInterface(int fd, std::span<char> buf) {
+    rtmsg body{};
+    body.rtm_family = AF_UNSPEC;
+    if (!requestDump(fd, RTM_GETROUTE, 1, body)) return 0;
+
+    int best = 0;
+    std::pair<bool, uint32_t> best_rank{false, UINT32_MAX};  // {IPv6, metric}
+    readDump(fd, 1, buf, [&](const nlmsghdr* header) {
+        if (header->nlmsg_type != RTM_NEWROUTE) return;
+        const auto* route = static_cast<const rtmsg*>(NLMSG_DATA(header));
+        if (route->rtm_dst_len != 0 || route->rtm_type != RTN_UNICAST) return;
+
+        uint32_t table = route->rtm_table;
+        uint32_t metric = 0;
+        int index = 0;
+        forEachAttribute(RTM_RTA(route), RTM_PAYLOAD(header), [&](unsigned type, std::span<const char> payload) {
+            if (type == RTA_TABLE) table = attributeValue<uint32_t>(payload);
+            else if (type == RTA_PRIORITY) metric = attributeValue<uint32_t>(payload);
+            else if (type == RTA_OIF) index = attributeValue<int>(payload);
+            else if (type == RTA_MULTIPATH && index == 0 && payload.size() >= sizeof(rtnexthop)) {
+                index = attributeValue<rtnexthop>(payload).rtnh_ifindex;
+            }
+        });
+        std::pair<bool, uint32_t> rank{route->rtm_family == AF_INET6, metric};
+        if (table == RT_TABLE_MAIN && index > 0 && rank < best_rank) {
+            best = index;
+            best_rank = rank;
+        }
+    });
+    return best;
+}
+
+// Name of interface index, or with index 0 the first link that is up,
+// running and not loopback (whose index is stored back)
+static std::string linkName(int fd, std::span<char> buf, int& index) {
+    ifinfomsg body{};
+    body.ifi_family = AF_UNSPEC;
+    if (!requestDump(fd, RTM_GETLINK, 2, body)) return "";
+
+    std::string name;
+    readDump(fd, 2, buf, [&](const nlmsghdr* header) {
+        if (header->nlmsg_type != RTM_NEWLINK || !name.empty()) return;
+        const auto* link = static_cast<const ifinfomsg*>(NLMSG_DATA(header));
+        if (index != 0 ? link->ifi_index != index
+                       : (link->ifi_flags & (IFF_UP | IFF_RUNNING | IFF_LOOPBACK)) != (IFF_UP | IFF_RUNNING)) {
+            return;
+        }
+        forEachAttribute(IFLA_RTA(link), IFLA_PAYLOAD(header), [&](unsigned type, std::span<const char> payload) {
+            if (type == IFLA_IFNAME) name.assign(payload.data(), strnlen(payload.data(), payload.size()));
+        });
+        if (!name.empty()) index = link->ifi_index;
+    });
+    return name;
+}
+
+// Primary IPv4 and best-ranked IPv6 address of interface index
+static void linkAddresses(int fd, std::span<char> buf, int index, NetworkInfo& network) {
+    ifaddrmsg body{};
+    body.ifa_family = AF_UNSPEC;
+    if (!requestDump(fd, RTM_GETADDR, 3, body)) return;
+
+    int ipv6_rank = 0;
+    readDump(fd, 3, buf, [&](const nlmsghdr* header) {
+        if (header->nlmsg_type != RTM_NEWADDR) return;
+        const auto* address = static_cast<const ifaddrmsg*>(NLMSG_DATA(header));
+        if (static_cast<int>(address->ifa_index) != index) return;
+
+        uint32_t flags = address->ifa_flags;
+        std::span<const char> local, peer;
+        forEachAttribute(IFA_RTA(address), IFA_PAYLOAD(header), [&](unsigned type, std::span<const char> payload) {
+            if (type == IFA_LOCAL) local = payload;
+            else if (type == IFA_ADDRESS) peer = payload;
+            else if (type == IFA_FLAGS) flags = attributeValue<uint32_t>(payload);
+        });
+
+        // IPv6: global and stable, global, then anything else; never
+        // one that is tentative or deprecated
+        int rank = 0;
+        if (address->ifa_family == AF_INET) {
+            if (!network.ipv4.empty() || (flags & IFA_F_SECONDARY)) return;
+            if (local.empty()) local = peer;  // IFA_LOCAL differs only on point-to-point links
+        } else if (address->ifa_family == AF_INET6) {
+            if (flags & (IFA_F_TENTATIVE | IFA_F_DEPRECATED)) return;
+            rank = address->ifa_scope != RT_SCOPE_UNIVERSE ? 1 : (flags & IFA_F_TEMPORARY) ? 2 : 3;
+            if (rank <= ipv6_rank) return;
+            local = peer;
+        } else {
+            return;
+        }
+
+        size_t address_size = address->ifa_family == AF_INET ? sizeof(in_addr) : sizeof(in6_addr);
+        char text[INET6_ADDRSTRLEN];
+        if (local.size() < address_size || !inet_ntop(address->ifa_family, local.data(), text, sizeof(text))) return;
+        std::string& out = address->ifa_family == AF_INET ? network.ipv4 : network.ipv6;
+        out = text;
+        out += '/';
+        appendNumber(out, address->ifa_prefixlen);
+        if (rank) ipv6_rank = rank;
+    });
+}
+
+bool readNetwork(NetworkInfo& network) {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) return false;
+
+    // Dumps come in messages of up to 32 KiB
+    alignas(nlmsghdr) char buf[32768];
+    int index = defaultRouteInterface(fd, buf);
+    network.interface = linkName(fd, buf, index);
+    if (!network.interface.empty()) linkAddresses(fd, buf, index, network);
+    close(fd);
+    if (network.interface.empty()) return false;
+
+    std::string path = "/sys/class/net/" + network.interface + "/speed";
+    char line[32];
+    std::string_view speed = readPseudoLine(path.c_str(), line);
+    int mbps = 0;
+    std::from_chars(speed.data(), speed.data() + speed.size(), mbps);
+    network.speed_mbps = mbps > 0 ? mbps : 0;
+    return true;
+}
+
+#else
+
+bool readNetwork(NetworkInfo&) {
+    return false;
+}
+
+#endif
+
+} // namespace kfetch
@@ -0,0 +1,24 @@
+#ifndef NETWORK_H
+#define NETWORK_H
+
+#include <string>
+
+namespace kfetch {
+
+// The interface traffic leaves by and its addresses
+struct NetworkInfo {
+    std::string interface;  // e.g. "eth0"
+    std::string ipv4;       // Primary address with prefix, e.g. "192.168.1.20/24"
+    std::string ipv6;       // Global (stable before temporary) over link-local
+    unsigned speed_mbps = 0;  // 0 when unknown, as for virtual and wireless links
+};
+
+// Route, link and address dumps over one rtnetlink socket, parsed in the
+// receive buffer. The interface is the one of the default route (IPv4
+// before IPv6, lowest metric first), else the first running non-loopback
+// link; the speed comes from /sys/class/net/<interface>/speed.
+bool readNetwork(NetworkInfo& network);
+
+} // namespace kfetch
+
+#endif // NETWORK_H
@@ -0,0 +1,109 @@
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace kfetch {
+
+// Number and unit formatting on std::to_chars. Every helper appends to a
+// caller's string (std::string or std::pmr::string), so building a line
+// takes no streams, no locale and no temporaries.
+
+template <typename String, std::integral T>
+void appendNumber(String& out, T value) {
+    char buf[24];  // Any 64-bit integer with its sign
+    auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+// value with exactly precision decimals; %g-style if it is too large
+template <typename String>
+void appendFixed(String& out, double value, int precision) {
+    char buf[64];
+    auto result = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, precision);
+    if (result.ec != std::errc()) {
+        result = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, precision);
+    }
+    out.append(buf, result.ptr);
+}
+
+// Fixed-point integer: appendDecimal(out, 370, 2) gives "3.70"
+template <typename String>
+void appendDecimal(String& out, int64_t scaled, unsigned decimals) {
+    uint64_t magnitude = scaled < 0 ? 0 - static_cast<uint64_t>(scaled) : static_cast<uint64_t>(scaled);
+    if (scaled < 0) out += '-';
+
+    uint64_t divisor = 1;
+    for (unsigned i = 0; i < decimals; i++) divisor *= 10;
+    appendNumber(out, magnitude / divisor);
+    if (decimals == 0) return;
+
+    char digits[20];
+    uint64_t fraction = magnitude % divisor;
+    for (unsigned i = decimals; i-- > 0;) {
+        digits[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    out += '.';
+    out.append(digits, decimals);
+}
+
+// "1 day", "2 days": the unit gets an "s" for counts above one
+template <typename String>
+void appendCount(String& out, uint64_t count, std::string_view unit) {
+    appendNumber(out, count);
+    out += ' ';
+    out += unit;
+    if (count > 1) out += 's';
+}
+
+// Bytes scaled to the largest binary unit below them, e.g. "1.5 GiB";
+// plain bytes are printed without decimals
+template <typename String>
+void appendBytes(String& out, uint64_t bytes, int precision = 1) {
+    static constexpr std::string_view units[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB"};
+    size_t unit = 0;
+    while (unit + 1 < std::size(units) && bytes >= uint64_t{1024} << (10 * unit)) unit++;
+
+    if (unit == 0) {
+        appendNumber(out, bytes);
+    } else {
+        appendFixed(out, static_cast<double>(bytes) / static_cast<double>(uint64_t{1} << (10 * unit)), precision);
+    }
+    out += ' ';
+    out += units[unit];
+}
+
+// "used MB / total MB" in whole MiB, the memory, swap and node lines
+template <typename String>
+void appendUsage(String& out, uint64_t used_bytes, uint64_t total_bytes) {
+    appendNumber(out, used_bytes >> 20);
+    out += " MB / ";
+    appendNumber(out, total_bytes >> 20);
+    out += " MB";
+}
+
+// "3 days, 4 hours, 5 mins": days and hours only when non-zero
+template <typename String>
+void appendDuration(String& out, uint64_t seconds) {
+    uint64_t days = seconds / 86400;
+    uint64_t hours = seconds % 86400 / 3600;
+    uint64_t minutes = seconds % 3600 / 60;
+    if (days > 0) {
+        appendCount(out, days, "day");
+        out += ", ";
+    }
+    if (hours > 0) {
+        appendCount(out, hours, "hour");
+        out += ", ";
+    }
+    appendCount(out, minutes, "min");
+}
+
+} // namespace kfetch
+
+#endif // NUMFMT_H
@@ -0,0 +1,609 @@
+#include "packages.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+    #include <sys/syscall.h>
+#endif
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace kfetch {
+
+// Next position p in [from, end) with p[0] == '\n' and p[1] == first,
+// i.e. the newline in front of a line starting with `first`; end if none
+static const char* findLineStart(const char* from, const char* end, char first) {
+    const char* p = from;
+#if defined(__SSE2__)
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i lead = _mm_set1_epi8(first);
+    // Compare 16 newline candidates against the byte after each of them
+    for (; p + 17 <= end; p += 16) {
+        __m128i here = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(here, newline),
+                                                        _mm_cmpeq_epi8(next, lead)));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+#endif
+    while (p + 1 < end) {
+        p = static_cast<const char*>(std::memchr(p, '\n', end - 1 - p));
+        if (!p) return end;
+        if (p[1] == first) return p;
+        p++;
+    }
+    return end;
+}
+
+int countDpkgPackages(const std::string& status_path) {
+    MappedFile status(status_path);
+    if (!status.data()) return access(status_path.c_str(), R_OK) == 0 ? 0 : -1;
+
+    constexpr std::string_view field = "Status: ";
+    constexpr std::string_view installed = " installed";
+
+    // Only the first line of the file can start without a preceding newline,
+    // and a stanza never begins with Status:, so scanning for "\nS" is enough
+    const char* p = status.data();
+    const char* end = p + status.size();
+    int count = 0;
+
+    while ((p = findLineStart(p, end, 'S')) != end) {
+        const char* line = p + 1;
+        if (static_cast<size_t>(end - line) < field.size() ||
+            std::memcmp(line, field.data(), field.size()) != 0) {
+            p = line;
+            continue;
+        }
+
+        const char* eol = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!eol) eol = end;
+        std::string_view value(line + field.size(), eol - line - field.size());
+        // "install ok installed", "hold ok installed", ...; not config-files
+        if (value.ends_with(installed) && value.find(" ok ") != std::string_view::npos) count++;
+        p = eol;
+    }
+
+    return count;
+}
+
+// Directories exactly depth levels below dirfd, skipping dot entries;
+// takes ownership of dirfd
+static int countDirs(int dirfd, int depth) {
+    auto isDir = [dirfd](const char* name, unsigned char type) {
+        if (name[0] == '.') return false;
+        if (type != DT_UNKNOWN) return type == DT_DIR;
+        struct stat st;
+        return fstatat(dirfd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+    };
+    auto visit = [&](const char* name) {
+        if (depth == 1) return 1;
+        int sub = openat(dirfd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        return sub < 0 ? 0 : countDirs(sub, depth - 1);
+    };
+
+    int count = 0;
+#ifdef __linux__
+    // Raw getdents64 into a stack buffer: no DIR allocation, few syscalls
+    struct linux_dirent64 {
+        uint64_t d_ino;
+        int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[];
+    };
+    alignas(linux_dirent64) char buffer[16384];
+    long n;
+    while ((n = syscall(SYS_getdents64, dirfd, buffer, sizeof(buffer))) > 0) {
+        for (long off = 0; off < n;) {
+            auto* entry = reinterpret_cast<linux_dirent64*>(buffer + off);
+            if (isDir(entry->d_name, entry->d_type)) count += visit(entry->d_name);
+            off += entry->d_reclen;
+        }
+    }
+    close(dirfd);
+    return n < 0 ? -1 : count;
+#else
+    DIR* dir = fdopendir(dirfd);
+    if (!dir) {
+        close(dirfd);
+        return -1;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        if (isDir(entry->d_name, entry->d_type)) count += visit(entry->d_name);
+    }
+    closedir(dir);
+    return count;
+#endif
+}
+
+static int countDirs(const std::string& path, int depth) {
+    int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    return fd < 0 ? -1 : countDirs(fd, depth);
+}
+
+int countPacmanPackages(const std::string& local_dir) {
+    // One directory per package; ALPM_DB_VERSION is a plain file
+    return countDirs(local_dir, 1);
+}
+
+int countPortagePackages(const std::string& db_dir) {
+    // <category>/<package-version>
+    return countDirs(db_dir, 2);
+}
+
+int countXbpsPackages(const std::string& db_dir) {
+    glob_t matches{};
+    std::string pattern = db_dir + "/pkgdb-*.plist";
+    if (glob(pattern.c_str(), 0, nullptr, &matches) != 0) {
+        globfree(&matches);
+        return -1;
+    }
+    // Newest format version sorts last
+    MappedFile plist(matches.gl_pathv[matches.gl_pathc - 1]);
+    globfree(&matches);
+    if (!plist.data()) return -1;
+
+    // The pkgdb is one top-level <dict> mapping package names to <dict>s,
+    // plus _XBPS_* bookkeeping keys that are not packages
+    const char* p = plist.data();
+    const char* end = p + plist.size();
+    int depth = 0;
+    int count = 0;
+    bool package_key = false;
+
+    while ((p = static_cast<const char*>(std::memchr(p, '<', end - p)))) {
+        std::string_view tag(p, std::min<size_t>(end - p, 8));
+        if (tag.starts_with("<dict/>")) {
+            package_key = false;
+        } else if (tag.starts_with("<dict>")) {
+            if (depth == 1 && package_key) count++;
+            package_key = false;
+            depth++;
+        } else if (tag.starts_with("</dict>")) {
+            depth--;
+        } else if (tag.starts_with("<key>")) {
+            const char* name = p + 5;
+            package_key = depth == 1 && std::string_view(name, std::min<size_t>(end - name, 6)) != "_XBPS_";
+        } else if (!tag.starts_with("</key>")) {
+            package_key = false;
+        }
+        p++;
+    }
+
+    return count;
+}
+
+int countApkPackages(const std::string& installed_path) {
+    MappedFile installed(installed_path);
+    if (!installed.data()) return access(installed_path.c_str(), R_OK) == 0 ? 0 : -1;
+
+    const char* p = installed.data();
+    const char* end = p + installed.size();
+    int count = installed.size() >= 2 && p[0] == 'P' && p[1] == ':';
+
+    while ((p = findLineStart(p, end, 'P')) != end) {
+        if (end - p > 2 && p[2] == ':') count++;
+        p++;
+    }
+
+    return count;
+}
+
+namespace {
+
+uint32_t readBE16(const unsigned char* p) { return (p[0] << 8) | p[1]; }
+uint32_t readBE32(const unsigned char* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+// SQLite varint: 1-9 bytes, big-endian 7-bit groups, 9th byte uses all 8 bits
+const unsigned char* readSqliteVarint(const unsigned char* p, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for (int i = 0; i < 9 && p < end; i++) {
+        unsigned char byte = *p++;
+        if (i == 8) {
+            value = (value << 8) | byte;
+            return p;
+        }
+        value = (value << 7) | (byte & 0x7f);
+        if (!(byte & 0x80)) return p;
+    }
+    return nullptr;
+}
+
+// Minimal read-only view of an SQLite 3 database file: pages come from the
+// last committed WAL frame that holds them, otherwise from the main file
+class SqliteFile {
+private:
+    int db_fd = -1;
+    int wal_fd = -1;
+    uint32_t page_size = 0;
+    uint32_t usable_size = 0;
+    uint32_t page_count = 0;
+    std::unordered_map<uint32_t, off_t> wal_frames;  // Page number -> page data offset
+
+    void loadWal(const std::string& path);
+
+public:
+    explicit SqliteFile(const std::string& path);
+    SqliteFile(const SqliteFile&) = delete;
+    SqliteFile& operator=(const SqliteFile&) = delete;
+    ~SqliteFile() {
+        if (db_fd >= 0) close(db_fd);
+        if (wal_fd >= 0) close(wal_fd);
+    }
+
+    bool valid() const { return page_size != 0; }
+    uint32_t usable() const { return usable_size; }
+    bool readPage(uint32_t pgno, std::vector<unsigned char>& page) const;
+
+    // Root page of the table called name, 0 if there is none
+    uint32_t tableRoot(std::string_view name) const;
+
+    // Number of rows in the table B-tree rooted at root, -1 if malformed
+    long countRows(uint32_t root) const;
+
+    // Call fn(cell payload, payload size) for every table leaf cell
+    template<typename Fn>
+    bool forEachCell(uint32_t root, Fn fn) const;
+};
+
+SqliteFile::SqliteFile(const std::string& path) {
+    db_fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (db_fd < 0) return;
+
+    unsigned char header[100];
+    if (pread(db_fd, header, sizeof(header), 0) != sizeof(header) ||
+        std::memcmp(header, "SQLite format 3", 16) != 0) return;
+
+    uint32_t size = readBE16(header + 16);
+    if (size == 1) size = 65536;
+    if (size < 512 || (size & (size - 1))) return;
+
+    struct stat st;
+    if (fstat(db_fd, &st) != 0) return;
+    page_size = size;
+    usable_size = size - header[20];
+    page_count = st.st_size / size;
+
+    loadWal(path + "-wal");
+}
+
+void SqliteFile::loadWal(const std::string& path) {
+    wal_fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (wal_fd < 0) return;
+
+    unsigned char header[32];
+    if (pread(wal_fd, header, sizeof(header), 0) != sizeof(header)) return;
+    uint32_t magic = readBE32(header);
+    if ((magic & ~1u) != 0x377f0682 || readBE32(header + 8) != page_size) return;
+
+    // Frame checksums chain from the header's; words are big-endian when
+    // the magic's low bit is set, little-endian otherwise
+    bool big_endian = magic & 1;
+    auto checksum = [big_endian](const unsigned char* data, size_t len, uint32_t& s0, uint32_t& s1) {
+        for (size_t i = 0; i + 8 <= len; i += 8) {
+            uint32_t a, b;
+            if (big_endian) {
+                a = readBE32(data + i);
+                b = readBE32(data + i + 4);
+            } else {
+                std::memcpy(&a, data + i, 4);
+                std::memcpy(&b, data + i + 4, 4);
+            }
+            s0 += a + s1;
+            s1 += b + s0;
+        }
+    };
+
+    uint32_t s0 = 0, s1 = 0;
+    checksum(header, 24, s0, s1);
+    if (s0 != readBE32(header + 24) || s1 != readBE32(header + 28)) return;
+
+    std::vector<unsigned char> frame(24 + page_size);
+    std::unordered_map<uint32_t, off_t> pending;
+    for (off_t off = sizeof(header);; off += frame.size()) {
+        if (pread(wal_fd, frame.data(), frame.size(), off) != static_cast<ssize_t>(frame.size())) break;
+        if (std::memcmp(frame.data() + 8, header + 16, 8) != 0) break;  // Salts of an older WAL
+
+        checksum(frame.data(), 8, s0, s1);
+        checksum(frame.data() + 24, page_size, s0, s1);
+        if (s0 != readBE32(frame.data() + 16) || s1 != readBE32(frame.data() + 20)) break;
+
+        pending[readBE32(frame.data())] = off + 24;
+        if (uint32_t commit_size = readBE32(frame.data() + 4)) {
+            // Only frames up to a commit record are visible
+            for (const auto& [pgno, data] : pending) wal_frames[pgno] = data;
+            pending.clear();
+            page_count = commit_size;
+        }
+    }
+}
+
+bool SqliteFile::readPage(uint32_t pgno, std::vector<unsigned char>& page) const {
+    if (pgno == 0 || pgno > page_count) return false;
+    page.resize(page_size);
+
+    auto frame = wal_frames.find(pgno);
+    if (frame != wal_frames.end()) {
+        return pread(wal_fd, page.data(), page_size, frame->second) == static_cast<ssize_t>(page_size);
+    }
+    return pread(db_fd, page.data(), page_size, off_t(pgno - 1) * page_size) == static_cast<ssize_t>(page_size);
+}
+
+template<typename Fn>
+bool SqliteFile::forEachCell(uint32_t root, Fn fn) const {
+    std::vector<uint32_t> stack{root};
+    std::vector<unsigned char> page;
+    size_t visited = 0;
+
+    while (!stack.empty()) {
+        uint32_t pgno = stack.back();
+        stack.pop_back();
+        if (++visited > page_count || !readPage(pgno, page)) return false;
+
+        // Page 1 starts with the 100-byte database header
+        const unsigned char* hdr = page.data() + (pgno == 1 ? 100 : 0);
+        const unsigned char* end = page.data() + usable_size;
+        uint32_t cells = readBE16(hdr + 3);
+
+        if (hdr[0] == 0x05) {          // Interior table page
+            const unsigned char* pointers = hdr + 12;
+            if (pointers + 2 * cells > end) return false;
+            for (uint32_t i = 0; i < cells; i++) {
+                uint32_t off = readBE16(pointers + 2 * i);
+                if (off + 4 > usable_size) return false;
+                stack.push_back(readBE32(page.data() + off));
+            }
+            stack.push_back(readBE32(hdr + 8));
+        } else if (hdr[0] == 0x0d) {   // Leaf table page
+            const unsigned char* pointers = hdr + 8;
+            if (pointers + 2 * cells > end) return false;
+            for (uint32_t i = 0; i < cells; i++) {
+                uint32_t off = readBE16(pointers + 2 * i);
+                if (off >= usable_size) return false;
+                if (!fn(page.data() + off, end)) return true;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t SqliteFile::tableRoot(std::string_view name) const {
+    uint32_t root = 0;
+
+    // sqlite_schema(type, name, tbl_name, rootpage, sql) lives at page 1
+    forEachCell(1, [&](const unsigned char* cell, const unsigned char* end) {
+        uint64_t payload_size, rowid;
+        const unsigned char* p = readSqliteVarint(cell, end, payload_size);
+        if (p) p = readSqliteVarint(p, end, rowid);
+        if (!p) return true;
+
+        // Only the locally stored part of the payload is read; the first
+        // four columns come before the (possibly spilled) sql text
+        uint64_t max_local = usable_size - 35;
+        uint64_t local = payload_size;
+        if (payload_size > max_local) {
+            uint64_t min_local = (uint64_t(usable_size - 12) * 32 / 255) - 23;
+            local = min_local + (payload_size - min_local) % (usable_size - 4);
+            if (local > max_local) local = min_local;
+        }
+        const unsigned char* record_end = std::min(end, p + local);
+
+        uint64_t header_size;
+        const unsigned char* types = readSqliteVarint(p, record_end, header_size);
+        if (!types || p + header_size > record_end) return true;
+        const unsigned char* body = p + header_size;
+
+        std::string_view columns[3];
+        int64_t rootpage = 0;
+        for (int col = 0; col < 4; col++) {
+            uint64_t type;
+            types = readSqliteVarint(types, p + header_size, type);
+            if (!types) return true;
+
+            static constexpr uint8_t int_sizes[] = {0, 1, 2, 3, 4, 6, 8, 8, 0, 0};
+            uint64_t len = type >= 12 ? (type - 12) / 2 : type < 10 ? int_sizes[type] : 0;
+            if (body + len > record_end) return true;
+
+            if (col < 3 && type >= 13 && type % 2) {
+                columns[col] = std::string_view(reinterpret_cast<const char*>(body), len);
+            } else if (col == 3) {
+                if (type == 8 || type == 9) rootpage = type - 8;
+                for (uint64_t i = 0; i < len && type <= 6; i++) rootpage = (rootpage << 8) | body[i];
+            }
+            body += len;
+        }
+
+        if (columns[0] == "table" && columns[1] == name) {
+            root = static_cast<uint32_t>(rootpage);
+            return false;
+        }
+        return true;
+    });
+
+    return root;
+}
+
+long SqliteFile::countRows(uint32_t root) const {
+    long rows = 0;
+    bool ok = forEachCell(root, [&](const unsigned char*, const unsigned char*) {
+        rows++;
+        return true;
+    });
+    return ok ? rows : -1;
+}
+
+} // namespace
+
+static int countSqliteRows(const std::string& path, std::string_view table) {
+    SqliteFile db(path);
+    if (!db.valid()) return -1;
+
+    uint32_t root = db.tableRoot(table);
+    if (root == 0) return -1;
+    return static_cast<int>(db.countRows(root));
+}
+
+int countRpmPackages(const std::string& rpm_dir) {
+    return countSqliteRows(rpm_dir + "/rpmdb.sqlite", "Packages");
+}
+
+int countPkgPackages(const std::string& db_dir) {
+    return countSqliteRows(db_dir + "/local.sqlite", "packages");
+}
+
+int countFlatpakPackages(const std::string& install_dir) {
+    // Installed refs are <kind>/<id>/<arch>/<branch>
+    int apps = countDirs(install_dir + "/app", 3);
+    int runtimes = countDirs(install_dir + "/runtime", 3);
+    if (apps < 0 && runtimes < 0) return -1;
+    return std::max(apps, 0) + std::max(runtimes, 0);
+}
+
+int countSnapPackages(const std::string& snap_dir, const std::string& snaps_dir) {
+    // /snap/<name> per mounted snap, plus /snap/bin
+    int mounted = countDirs(snap_dir, 1);
+    if (mounted > 0) return mounted - (access((snap_dir + "/bin").c_str(), F_OK) == 0);
+
+    // Otherwise distinct names among <name>_<revision>.snap
+    glob_t matches{};
+    std::string pattern = snaps_dir + "/*.snap";
+    if (glob(pattern.c_str(), 0, nullptr, &matches) != 0) {
+        globfree(&matches);
+        return -1;
+    }
+    std::unordered_set<std::string_view> names;
+    for (size_t i = 0; i < matches.gl_pathc; i++) {
+        std::string_view file = matches.gl_pathv[i];
+        file.remove_prefix(file.rfind('/') + 1);
+        names.insert(file.substr(0, file.rfind('_')));
+    }
+    int count = static_cast<int>(names.size());
+    globfree(&matches);
+    return count;
+}
+
+int countNixPackages(const std::string& profile_dir) {
+    // nix profile: one "storePaths" per element; nix-env: one derivation each
+    for (auto [file, marker] : {std::pair{"/manifest.json", std::string_view("\"storePaths\"")},
+                                std::pair{"/manifest.nix", std::string_view("type = \"derivation\"")}}) {
+        MappedFile manifest(profile_dir + file);
+        if (!manifest.data()) continue;
+
+        int count = 0;
+        const char* p = manifest.data();
+        const char* end = p + manifest.size();
+        while ((p = static_cast<const char*>(memmem(p, end - p, marker.data(), marker.size())))) {
+            count++;
+            p += marker.size();
+        }
+        return count;
+    }
+    return -1;
+}
+
+std::vector<std::pair<std::string, int>> countPackages(const std::string& sysroot, unsigned workers) {
+    auto path = [&](const char* p) { return resolveUnder(sysroot, p); };
+    auto exists = [&](const char* p) { return access(path(p).c_str(), F_OK) == 0; };
+    std::string quoted_root = shellQuote(sysroot.empty() ? "/" : sysroot);
+    const char* home = sysroot.empty() ? std::getenv("HOME") : nullptr;
+    auto inHome = [&](const char* p) { return std::string(home) + p; };
+
+    // Adds two counts where either may be -1 (missing)
+    auto sum = [](int a, int b) { return a < 0 ? b : b < 0 ? a : a + b; };
+
+    // A reader only runs when one of its markers exists: under sysroot,
+    // or below $HOME for the per-user installs of the host
+    struct Detector {
+        const char* manager;
+        std::array<const char*, 2> markers;
+        const char* home_marker;
+        std::function<int()> count;
+    };
+    const Detector detectors[] = {
+        {"pkg", {"/var/db/pkg/local.sqlite"}, nullptr, [&] {
+            int count = countPkgPackages(path("/var/db/pkg"));
+            if (count < 0 && sysroot.empty()) {
+                std::string result = executeCommand("pkg info -a 2>/dev/null | wc -l");
+                if (!result.empty()) count = std::stoi(result);
+            }
+            return count;
+        }},
+        {"dpkg", {"/var/lib/dpkg/status"}, nullptr, [&] { return countDpkgPackages(path("/var/lib/dpkg/status")); }},
+        // Newer distros keep the rpmdb in /usr/lib/sysimage/rpm and
+        // symlink /var/lib/rpm to it
+        {"rpm", {"/usr/lib/sysimage/rpm", "/var/lib/rpm"}, nullptr, [&] {
+            int count = countRpmPackages(path("/usr/lib/sysimage/rpm"));
+            if (count < 0) count = countRpmPackages(path("/var/lib/rpm"));
+            if (count < 0) {
+                // Berkeley DB / ndb backends still need rpm itself
+                std::string result = executeCommand("rpm --root=" + quoted_root + " -qa 2>/dev/null | wc -l");
+                if (!result.empty()) count = std::stoi(result);
+            }
+            return count;
+        }},
+        {"pacman", {"/var/lib/pacman/local"}, nullptr, [&] { return countPacmanPackages(path("/var/lib/pacman/local")); }},
+        {"portage", {"/var/db/pkg"}, nullptr, [&] {
+            // FreeBSD's pkg shares /var/db/pkg
+            if (exists("/var/db/pkg/local.sqlite")) return -1;
+            return countPortagePackages(path("/var/db/pkg"));
+        }},
+        {"xbps", {"/var/db/xbps"}, nullptr, [&] { return countXbpsPackages(path("/var/db/xbps")); }},
+        {"apk", {"/lib/apk/db/installed"}, nullptr, [&] { return countApkPackages(path("/lib/apk/db/installed")); }},
+        {"flatpak", {"/var/lib/flatpak"}, "/.local/share/flatpak", [&] {
+            int count = countFlatpakPackages(path("/var/lib/flatpak"));
+            if (home) count = sum(count, countFlatpakPackages(inHome("/.local/share/flatpak")));
+            return count;
+        }},
+        {"snap", {"/snap", "/var/lib/snapd/snaps"}, nullptr, [&] {
+            return countSnapPackages(path("/snap"), path("/var/lib/snapd/snaps"));
+        }},
+        {"nix", {"/nix/var/nix/profiles/default"}, "/.nix-profile", [&] {
+            int count = countNixPackages(path("/nix/var/nix/profiles/default"));
+            if (home) count = sum(count, countNixPackages(inHome("/.nix-profile")));
+            return count;
+        }},
+    };
+
+    // A system has one or two of these, so probing first keeps a run (and
+    // every root of a --root scan) from starting a thread per manager
+    std::vector<const Detector*> present;
+    for (const Detector& detector : detectors) {
+        bool found = std::ranges::any_of(detector.markers, [&](const char* marker) { return marker && exists(marker); });
+        if (!found && home && detector.home_marker) found = access(inHome(detector.home_marker).c_str(), F_OK) == 0;
+        if (found) present.push_back(&detector);
+    }
+
+    // The slowest reader sets the latency, so by default each gets a thread
+    std::vector<int> counts(present.size());
+    parallelFor(present.size(), [&](size_t i) { counts[i] = present[i]->count(); },
+                workers ? workers : static_cast<unsigned>(present.size()));
+
+    std::vector<std::pair<std::string, int>> found;
+    for (size_t i = 0; i < present.size(); i++) {
+        if (counts[i] > 0) found.emplace_back(present[i]->manager, counts[i]);
+    }
+    return found;
+}
+
+} // namespace kfetch
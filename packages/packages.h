@@ -0,0 +1,53 @@
+#ifndef PACKAGES_H
+#define PACKAGES_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace kfetch {
+
+// Native package database readers. Each returns the number of installed
+// packages, or -1 when the database is missing or unreadable.
+
+// dpkg: stanzas of /var/lib/dpkg/status whose Status is "<want> ok installed"
+int countDpkgPackages(const std::string& status_path);
+
+// pacman: one directory per package in /var/lib/pacman/local
+int countPacmanPackages(const std::string& local_dir);
+
+// portage: <category>/<package> directories in /var/db/pkg
+int countPortagePackages(const std::string& db_dir);
+
+// xbps: package dictionaries in /var/db/xbps/pkgdb-*.plist
+int countXbpsPackages(const std::string& db_dir);
+
+// apk: "P:" records in /lib/apk/db/installed
+int countApkPackages(const std::string& installed_path);
+
+// rpm: rows of the Packages table in <rpm_dir>/rpmdb.sqlite, read straight
+// from the SQLite B-tree (and its WAL) without libsqlite or locks
+int countRpmPackages(const std::string& rpm_dir);
+
+// FreeBSD pkg: rows of the packages table in <db_dir>/local.sqlite
+int countPkgPackages(const std::string& db_dir);
+
+// flatpak: installed app and runtime refs of an installation directory
+int countFlatpakPackages(const std::string& install_dir);
+
+// snap: mounted snaps in /snap, else distinct names in /var/lib/snapd/snaps
+int countSnapPackages(const std::string& snap_dir, const std::string& snaps_dir);
+
+// nix: elements of a profile's manifest.json or manifest.nix
+int countNixPackages(const std::string& profile_dir);
+
+// Every package manager found under sysroot ("" = host, which also counts
+// the user's flatpak and nix profiles). Only the databases that exist are
+// read, concurrently on up to workers threads (0 = one per database, 1 =
+// all on the calling thread). Returns {manager, count} for the managers
+// with packages installed.
+std::vector<std::pair<std::string, int>> countPackages(const std::string& sysroot, unsigned workers = 0);
+
+} // namespace kfetch
+
+#endif // PACKAGES_H
@@ -0,0 +1,355 @@
+#include "procfs.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <optional>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+        #define HAVE_IO_URING
+    #endif
+#endif
+
+namespace kfetch {
+
+namespace {
+
+struct DirPath {
+    int dirfd;
+    const char* relative;
+};
+
+// Split off /proc or /sys, whose directory fds are opened on first use
+DirPath resolve(const char* path) {
+    std::string_view view(path);
+    if (view.starts_with("/proc/")) {
+        static const int proc = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (proc >= 0) return {proc, path + 6};
+    } else if (view.starts_with("/sys/")) {
+        static const int sys = open("/sys", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (sys >= 0) return {sys, path + 5};
+    }
+    return {AT_FDCWD, path};
+}
+
+#ifdef HAVE_IO_URING
+// io_uring on the raw syscalls, so there is no liburing dependency: one
+// submission and one completion ring, set up once per thread
+class Uring {
+public:
+    Uring() {
+        io_uring_params params{};
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, 64, &params));
+        if (fd < 0) return;
+        // OPENAT, READ and CLOSE arrived in 5.6 together with this feature bit
+        if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+            release();
+            return;
+        }
+
+        sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) sq_size = cq_size = std::max(sq_size, cq_size);
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+        sq_ring = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        cq_ring = single_mmap ? sq_ring
+                              : mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                     IORING_OFF_CQ_RING);
+        void* sqes_map = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                              IORING_OFF_SQES);
+        if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes_map == MAP_FAILED) {
+            if (sqes_map != MAP_FAILED) munmap(sqes_map, sqes_size);
+            release();
+            return;
+        }
+
+        char* sq = static_cast<char*>(sq_ring);
+        sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        char* cq = static_cast<char*>(cq_ring);
+        cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        sqes = static_cast<io_uring_sqe*>(sqes_map);
+        capacity = params.sq_entries;
+    }
+
+    ~Uring() { release(); }
+
+    Uring(const Uring&) = delete;
+    Uring& operator=(const Uring&) = delete;
+
+    bool valid() const { return fd >= 0; }
+
+    // Operations in flight must stay within capacity: the completion ring
+    // is twice as large, so it can never overflow
+    unsigned capacity = 0;
+
+    io_uring_sqe& queue(uint8_t opcode, uint64_t user_data) {
+        unsigned index = (*sq_tail + queued++) & sq_mask;
+        io_uring_sqe& sqe = sqes[index];
+        sqe = {};
+        sqe.opcode = opcode;
+        sqe.user_data = user_data;
+        sq_array[index] = index;
+        return sqe;
+    }
+
+    // Submit everything queued and wait for at least one completion
+    bool submit() {
+        __atomic_store_n(sq_tail, *sq_tail + queued, __ATOMIC_RELEASE);
+        queued = 0;
+        for (;;) {
+            unsigned pending = *sq_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+            if (syscall(__NR_io_uring_enter, fd, pending, 1, IORING_ENTER_GETEVENTS, nullptr, 0) >= 0) return true;
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return false;
+        }
+    }
+
+    // Call done(user_data, result) for every completion posted so far
+    template <typename Done>
+    void reap(Done done) {
+        unsigned head = *cq_head;
+        unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++, reaped++) {
+            const io_uring_cqe& cqe = cqes[head & cq_mask];
+            done(cqe.user_data, cqe.res);
+        }
+        __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+    }
+
+    // Wait until every request the kernel has taken from the submission
+    // ring has completed, reaping as above; false if waiting failed and
+    // some may still be running. Queued requests it never took stay there.
+    template <typename Done>
+    bool drain(Done done) {
+        for (;;) {
+            reap(done);
+            // Each request taken posts exactly one completion
+            if (__atomic_load_n(sq_head, __ATOMIC_ACQUIRE) == reaped) return true;
+            if (syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+                return false;
+            }
+        }
+    }
+
+private:
+    int fd = -1;
+    void* sq_ring = MAP_FAILED;
+    void* cq_ring = MAP_FAILED;
+    size_t sq_size = 0;
+    size_t cq_size = 0;
+    size_t sqes_size = 0;
+    unsigned* sq_head = nullptr;
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned sq_mask = 0;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned cq_mask = 0;
+    io_uring_cqe* cqes = nullptr;
+    io_uring_sqe* sqes = nullptr;
+    unsigned queued = 0;
+    unsigned reaped = 0;  // Completions seen, against *sq_head's requests taken
+
+    void release() {
+        if (sqes) munmap(sqes, sqes_size);
+        if (cq_ring != MAP_FAILED && cq_ring != sq_ring) munmap(cq_ring, cq_size);
+        if (sq_ring != MAP_FAILED) munmap(sq_ring, sq_size);
+        if (fd >= 0) close(fd);
+        fd = -1;
+        sqes = nullptr;
+        sq_ring = cq_ring = MAP_FAILED;
+    }
+};
+#endif
+
+// Below this many files the ring round trips cost more than they save
+constexpr size_t MIN_URING_BATCH = 8;
+
+} // namespace
+
+std::string_view readPseudoFile(const char* path, std::span<char> buf) {
+    DirPath at = resolve(path);
+    int fd = openat(at.dirfd, at.relative, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return {};
+
+    // Pseudo-files may hand out their contents in several reads
+    size_t length = 0;
+    while (length < buf.size()) {
+        ssize_t got = read(fd, buf.data() + length, buf.size() - length);
+        if (got <= 0) break;
+        length += got;
+    }
+    close(fd);
+    return {buf.data(), length};
+}
+
+std::string_view readPseudoFile(const char* path) {
+    thread_local char buf[64 * 1024];
+    return readPseudoFile(path, buf);
+}
+
+std::string_view readPseudoLine(const char* path, std::span<char> buf) {
+    std::string_view content = readPseudoFile(path, buf);
+    content = content.substr(0, content.find('\n'));
+    while (!content.empty() && (content.back() == ' ' || content.back() == '\t' || content.back() == '\r')) {
+        content.remove_suffix(1);
+    }
+    return content;
+}
+
+bool pathExists(const char* path) {
+    DirPath at = resolve(path);
+    return faccessat(at.dirfd, at.relative, F_OK, 0) == 0;
+}
+
+std::string_view readLink(const char* path, std::span<char> buf) {
+    DirPath at = resolve(path);
+    ssize_t length = readlinkat(at.dirfd, at.relative, buf.data(), buf.size());
+    if (length <= 0 || static_cast<size_t>(length) == buf.size()) return {};
+    return {buf.data(), static_cast<size_t>(length)};
+}
+
+void ReadBatch::add(const char* path, std::span<char> buf, Handler handler, void* context) {
+    reads.push_back({path, buf, handler, context});
+}
+
+void ReadBatch::run() {
+    runUring();
+
+    // Everything io_uring did not finish, or all of it without io_uring
+    for (Read& read : reads) {
+        if (read.fd >= 0) close(read.fd);  // Opened by the ring, never closed by it
+        if (read.done) continue;
+        read.done = true;
+        read.handler(read.context, readPseudoFile(read.path, read.buf));
+    }
+    reads.clear();
+}
+
+#ifdef HAVE_IO_URING
+bool ReadBatch::runUring() {
+    // io_uring hands every open and read of a /proc or /sys file to a
+    // worker thread, which costs more than the syscalls it saves: only
+    // regular paths go through the ring
+    size_t regular = std::count_if(reads.begin(), reads.end(),
+                                   [](const Read& read) { return resolve(read.path).dirfd == AT_FDCWD; });
+    if (regular < MIN_URING_BATCH) return false;
+
+    // Set up on a thread's first batch, and again after a failed one
+    thread_local std::optional<Uring> ring;
+    if (!ring) ring.emplace();
+    if (!ring->valid()) return false;
+
+    // user_data: index of the read, shifted, plus the operation
+    enum : uint64_t { OPEN, READ, CLOSE };
+    auto queueRead = [&](size_t index) {
+        Read& read = reads[index];
+        io_uring_sqe& sqe = ring->queue(IORING_OP_READ, index << 2 | READ);
+        sqe.fd = read.fd;
+        sqe.addr = reinterpret_cast<uintptr_t>(read.buf.data() + read.length);
+        sqe.len = static_cast<uint32_t>(read.buf.size() - read.length);
+        sqe.off = read.length;
+    };
+    auto finish = [&](size_t index) {
+        Read& read = reads[index];
+        io_uring_sqe& sqe = ring->queue(IORING_OP_CLOSE, index << 2 | CLOSE);
+        sqe.fd = read.fd;
+        read.done = true;
+        read.handler(read.context, {read.buf.data(), read.length});
+    };
+
+    // After a failed submit, before the ring is dropped: wait out whatever
+    // the kernel already took, so no read still lands in a buffer the
+    // fallback reuses and every fd the ring opened is known to run()
+    size_t next = 0;
+    auto abandon = [&] {
+        bool drained = ring->drain([&](uint64_t user_data, int result) {
+            Read& read = reads[user_data >> 2];
+            if ((user_data & 3) == OPEN && result >= 0) read.fd = result;
+            if ((user_data & 3) == CLOSE) read.fd = -1;
+        });
+        if (drained) return;
+
+        // Requests may still be running: their fds and buffers stay
+        // theirs, and the files they were reading come back empty
+        for (size_t index = 0; index < next; index++) {
+            Read& read = reads[index];
+            if (resolve(read.path).dirfd != AT_FDCWD) continue;
+            read.fd = -1;
+            if (read.done) continue;
+            read.done = true;
+            read.handler(read.context, {});
+        }
+    };
+
+    // Each file holds one slot from its open to its close; a completion
+    // that queues the next step hands its slot on
+    unsigned in_flight = 0;
+    for (;;) {
+        for (; next < reads.size() && in_flight < ring->capacity; next++) {
+            DirPath at = resolve(reads[next].path);
+            if (at.dirfd != AT_FDCWD) continue;
+            in_flight++;
+            io_uring_sqe& sqe = ring->queue(IORING_OP_OPENAT, next << 2 | OPEN);
+            sqe.fd = at.dirfd;
+            sqe.addr = reinterpret_cast<uintptr_t>(at.relative);
+            sqe.open_flags = O_RDONLY | O_CLOEXEC;
+        }
+        if (in_flight == 0) return true;
+        if (!ring->submit()) {
+            abandon();
+            ring.reset();
+            return false;
+        }
+
+        ring->reap([&](uint64_t user_data, int result) {
+            size_t index = user_data >> 2;
+            Read& read = reads[index];
+            switch (user_data & 3) {
+            case OPEN:
+                if (result < 0) {
+                    read.done = true;
+                    read.handler(read.context, {});
+                    in_flight--;
+                } else {
+                    read.fd = result;
+                    queueRead(index);
+                }
+                break;
+            case READ:
+                // Pseudo-files may hand out their contents in several reads
+                if (result > 0) read.length += result;
+                if (result > 0 && read.length < read.buf.size()) {
+                    queueRead(index);
+                } else {
+                    finish(index);
+                }
+                break;
+            case CLOSE:
+                read.fd = -1;
+                in_flight--;
+                break;
+            }
+        });
+    }
+}
+
+#else
+bool ReadBatch::runUring() {
+    return false;
+}
+#endif
+
+} // namespace kfetch
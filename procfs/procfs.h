@@ -0,0 +1,76 @@
+#ifndef PROCFS_H
+#define PROCFS_H
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <sys/types.h>
+
+namespace kfetch {
+
+// Reader for /proc, /sys and other small files. /proc and /sys are opened
+// once per process and files below them are reached with openat, so a
+// read is open/read/close into a fixed buffer and allocates nothing.
+// Paths outside them are opened as given.
+
+// Contents of path read into buf, truncated to its size; empty when the
+// file is missing or unreadable
+std::string_view readPseudoFile(const char* path, std::span<char> buf);
+
+// Same, into a 64 KiB thread-local buffer that the thread's next call reuses
+std::string_view readPseudoFile(const char* path);
+
+// First line of path without trailing whitespace, for one-value sysfs files
+std::string_view readPseudoLine(const char* path, std::span<char> buf);
+
+// faccessat(F_OK) through the cached directory
+bool pathExists(const char* path);
+
+// readlinkat through the cached directory; the target, or empty
+std::string_view readLink(const char* path, std::span<char> buf);
+
+// Reads of many files issued together. With io_uring (Linux 5.6+) every
+// openat of the batch goes to the kernel in one io_uring_enter and the
+// reads follow in bulk as the opens complete, so a batch costs a few
+// syscalls rather than four per file. /proc and /sys files, batches too
+// small to gain from it and kernels without io_uring are read one by one
+// with readPseudoFile. Either way each file's handler runs as soon as its read
+// has finished, with the contents (empty when missing or unreadable).
+class ReadBatch {
+public:
+    using Handler = void (*)(void* context, std::string_view content);
+
+    // path and buf must stay valid until run() returns
+    void add(const char* path, std::span<char> buf, Handler handler, void* context);
+
+    // parse(content) is called; parse must outlive run()
+    template <typename Parse>
+    void add(const char* path, std::span<char> buf, Parse& parse) {
+        add(path, buf, [](void* context, std::string_view content) { (*static_cast<Parse*>(context))(content); },
+            &parse);
+    }
+
+    // Read every file added so far and run its handler
+    void run();
+
+    size_t size() const { return reads.size(); }
+
+private:
+    struct Read {
+        const char* path;
+        std::span<char> buf;
+        Handler handler;
+        void* context;
+        int fd = -1;
+        size_t length = 0;
+        bool done = false;
+    };
+    std::vector<Read> reads;
+
+    bool runUring();
+};
+
+} // namespace kfetch
+
+#endif // PROCFS_H
@@ -0,0 +1,264 @@
+#include "prometheus.h"
+#include "utils.h"
+#include "baseline/baseline.h"
+#include "procfs/procfs.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <climits>
+#include <cstdlib>
+#include <tuple>
+#include <glob.h>
+#include <sys/stat.h>
+
+#if defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+    #include <sys/time.h>
+    #define BSD_SYSTEM
+#endif
+
+namespace kfetch {
+
+// Label values escape backslash, double quote and newline
+static std::string escapeLabel(std::string_view value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '"') out += "\\\"";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+    return out;
+}
+
+void PrometheusWriter::header(const std::string& name, const std::string& help) {
+    if (name == last_metric) return;
+    last_metric = name;
+    text += "# HELP " + name + " " + help + "\n";
+    text += "# TYPE " + name + " gauge\n";
+}
+
+void PrometheusWriter::gauge(const std::string& name, const std::string& help,
+                             double value, const PrometheusLabels& labels) {
+    header(name, help);
+
+    text += name;
+    if (!labels.empty()) {
+        text += '{';
+        for (size_t i = 0; i < labels.size(); i++) {
+            if (i > 0) text += ',';
+            text += labels[i].first;
+            text += "=\"";
+            text += escapeLabel(labels[i].second);
+            text += '"';
+        }
+        text += '}';
+    }
+
+    char number[32];
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        snprintf(number, sizeof(number), " %.0f\n", value);
+    } else {
+        snprintf(number, sizeof(number), " %.6g\n", value);
+    }
+    text += number;
+}
+
+bool PrometheusWriter::writeTo(const std::string& path) const {
+    return writeFileAtomic(path, text);
+}
+
+// Bumped whenever the cache layout or what a static collector reports
+// changes, so caches written by an older kfetch are rebuilt
+constexpr unsigned STATIC_CACHE_FORMAT = 2;
+
+// Identifies the state the static fields were collected in: the cache
+// format and the kfetch binary that wrote it, the boot, plus the mtimes
+// of the files the OS, shell and package fields come from
+static std::string staticStamp() {
+    std::string stamp = "format" + std::to_string(STATIC_CACHE_FORMAT);
+    struct stat exe;
+    if (stat("/proc/self/exe", &exe) == 0) {
+        stamp += ":exe" + std::to_string(exe.st_size) + "." + std::to_string(exe.st_mtime);
+    }
+
+    char boot_id[64];
+    stamp += ':';
+    stamp += readPseudoLine("/proc/sys/kernel/random/boot_id", boot_id);
+#ifdef BSD_SYSTEM
+    struct timeval boottime;
+    size_t size = sizeof(boottime);
+    if (portable_sysctlbyname("kern.boottime", &boottime, &size, NULL, 0) == 0) {
+        stamp += std::to_string(boottime.tv_sec);
+    }
+#endif
+    auto addMtime = [&](const std::string& path) {
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0) {
+            stamp += ':';
+            stamp += std::to_string(st.st_mtime);
+        }
+    };
+
+    // The SQLite databases commit to their -wal first, so a commit that
+    // has not been checkpointed yet only shows in the WAL's mtime
+    static const char* sources[] = {
+        "/etc/os-release", "/etc/passwd",
+        "/var/lib/dpkg/status", "/var/lib/rpm", "/var/lib/rpm/rpmdb.sqlite",
+        "/var/lib/rpm/rpmdb.sqlite-wal", "/var/lib/pacman/local", "/var/db/pkg",
+        "/var/db/pkg/local.sqlite", "/var/db/pkg/local.sqlite-wal", "/var/db/xbps",
+        "/lib/apk/db/installed", "/usr/lib/sysimage/rpm/rpmdb.sqlite",
+        "/usr/lib/sysimage/rpm/rpmdb.sqlite-wal", "/var/lib/flatpak/app",
+        "/var/lib/flatpak/runtime", "/snap", "/var/lib/snapd/snaps", "/nix/var/nix/profiles",
+    };
+    for (const char* path : sources) addMtime(path);
+
+    // Portage installs into /var/db/pkg/<category>/, which leaves the top
+    // directory's mtime alone
+    glob_t categories{};
+    if (glob("/var/db/pkg/*/", 0, nullptr, &categories) == 0) {
+        for (size_t i = 0; i < categories.gl_pathc; i++) addMtime(categories.gl_pathv[i]);
+    }
+    globfree(&categories);
+
+    // The per-user installs counted on the host. A nix profile links to a
+    // store path, whose mtime is always 1, so its target is stamped instead
+    auto addTarget = [&](const std::string& link) {
+        char target[PATH_MAX];
+        if (realpath(link.c_str(), target)) {
+            stamp += ':';
+            stamp += target;
+        }
+    };
+    addTarget("/nix/var/nix/profiles/default");
+    if (const char* home = std::getenv("HOME")) {
+        addMtime(std::string(home) + "/.local/share/flatpak/app");
+        addMtime(std::string(home) + "/.local/share/flatpak/runtime");
+        addTarget(std::string(home) + "/.nix-profile");
+    }
+    return stamp;
+}
+
+constexpr FieldMask STATIC_FIELDS =
+    FIELD_OS | FIELD_HOSTNAME | FIELD_KERNEL | FIELD_CPU | FIELD_SHELL | FIELD_GPU | FIELD_PACKAGES;
+
+// Fill info from a cache whose stamp matched; false, leaving info as it
+// was, if a package count does not parse (a truncated or corrupt file)
+static bool loadStaticCache(const Baseline& cached, Info& info) {
+    Info loaded;
+    for (const auto& [key, value] : cached) {
+        if (key.starts_with("packages.")) {
+            int count = 0;
+            auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), count);
+            if (ec != std::errc() || end != value.data() + value.size() || count < 0) return false;
+            loaded.package_counts.emplace_back(key.substr(9), count);
+            continue;
+        }
+        for (const auto& field : baselineFields()) {
+            if (key == field.key) loaded.*field.value = value;
+        }
+    }
+    info = std::move(loaded);
+    return true;
+}
+
+// Reuse the expensive static fields from the previous export when the
+// stamp still matches; otherwise collect them and refresh the cache
+static void collectStaticCached(Info& info) {
+    std::string dir = cacheDirectory();
+    std::string path = dir.empty() ? "" : dir + "/static.cache";
+    std::string stamp = staticStamp();
+
+    Baseline cached;
+    if (!path.empty() && loadBaseline(path, cached) &&
+        !cached.empty() && cached[0].first == "stamp" && cached[0].second == stamp &&
+        loadStaticCache(cached, info)) {
+        info.fields |= STATIC_FIELDS;
+        return;
+    }
+
+    collect(info, STATIC_FIELDS);
+    if (path.empty()) return;
+
+    std::string content = "stamp = " + stamp + "\n";
+    for (const auto& field : baselineFields()) {
+        content += field.key;
+        content += " = ";
+        content += info.*field.value;
+        content += '\n';
+    }
+    for (const auto& [manager, count] : info.package_counts) {
+        content += "packages.";
+        content += manager;
+        content += " = " + std::to_string(count) + "\n";
+    }
+    writeFileAtomic(path, content);
+}
+
+int exportPrometheus(const std::string& path) {
+    Info info;
+    collectStaticCached(info);
+    collect(info, FIELD_UPTIME | FIELD_MEMORY | FIELD_MEMORY_NODES | FIELD_DISKS | FIELD_NETWORK);
+
+    PrometheusWriter prom;
+    prom.gauge("kfetch_info", "Static system description collected by kfetch.", 1, {
+        {"distro", info.distro_name}, {"os", info.distro_pretty_name}, {"kernel", info.kernel},
+        {"cpu", info.cpu}, {"gpu", info.gpu}, {"gpu_driver", info.gpu_driver}, {"shell", info.shell},
+    });
+    prom.gauge("kfetch_memory_used_bytes", "Used memory in bytes.", info.memory_used_bytes);
+    prom.gauge("kfetch_memory_total_bytes", "Total memory in bytes.", info.memory_total_bytes);
+    prom.gauge("kfetch_memory_available_bytes", "Memory available without swapping, in bytes.",
+               info.memory_available_bytes);
+    prom.gauge("kfetch_memory_shmem_bytes", "Shared memory and tmpfs in bytes.", info.shmem_bytes);
+    prom.gauge("kfetch_hugepages_used_bytes", "Used huge pages in bytes.", info.hugepages_used_bytes);
+    prom.gauge("kfetch_hugepages_total_bytes", "Reserved huge pages in bytes.", info.hugepages_total_bytes);
+    prom.gauge("kfetch_swap_used_bytes", "Used swap in bytes.", info.swap_used_bytes);
+    prom.gauge("kfetch_swap_total_bytes", "Total swap in bytes.", info.swap_total_bytes);
+    for (const auto& node : info.memory_nodes) {
+        std::string id = std::to_string(node.node);
+        prom.gauge("kfetch_memory_node_used_bytes", "Used memory per NUMA node in bytes.",
+                   node.used_bytes, {{"node", id}});
+        prom.gauge("kfetch_memory_node_total_bytes", "Total memory per NUMA node in bytes.",
+                   node.total_bytes, {{"node", id}});
+    }
+    // A metric's samples must be consecutive, so one pass per metric
+    for (const auto& disk : info.disks) {
+        prom.gauge("kfetch_disk_responsive", "Whether statvfs answered within the timeout (0 for a hung mount).",
+                   disk.responsive, {{"mount", disk.mount_point}, {"fstype", disk.fs_type}});
+    }
+    static constexpr std::tuple<const char*, const char*, uint64_t Disk::*> disk_gauges[] = {
+        {"kfetch_disk_used_bytes", "Used space per mounted filesystem in bytes.", &Disk::used_bytes},
+        {"kfetch_disk_total_bytes", "Size of each mounted filesystem in bytes.", &Disk::total_bytes},
+        {"kfetch_disk_available_bytes", "Space available to unprivileged users per mounted filesystem, in bytes.",
+         &Disk::available_bytes},
+    };
+    for (const auto& [name, help, member] : disk_gauges) {
+        for (const auto& disk : info.disks) {
+            if (!disk.responsive) continue;
+            prom.gauge(name, help, disk.*member, {{"mount", disk.mount_point}, {"fstype", disk.fs_type}});
+        }
+    }
+    if (!info.network_interface.empty()) {
+        prom.gauge("kfetch_network_info", "Interface of the default route and its addresses.", 1, {
+            {"interface", info.network_interface}, {"ipv4", info.network_ipv4}, {"ipv6", info.network_ipv6},
+        });
+    }
+    if (info.network_speed_mbps > 0) {
+        prom.gauge("kfetch_network_speed_bytes", "Link speed of the default route's interface in bytes per second.",
+                   info.network_speed_mbps * 125000.0, {{"interface", info.network_interface}});
+    }
+    for (const auto& [manager, count] : info.package_counts) {
+        prom.gauge("kfetch_packages", "Installed packages per package manager.",
+                   count, {{"manager", manager}});
+    }
+    prom.gauge("kfetch_uptime_seconds", "System uptime in seconds.", info.uptime_seconds);
+
+    if (!prom.writeTo(path)) {
+        std::cerr << "kfetch: cannot write " << path << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace kfetch
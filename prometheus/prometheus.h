@@ -0,0 +1,39 @@
+#ifndef PROMETHEUS_H
+#define PROMETHEUS_H
+
+#include "libkfetch.h"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace kfetch {
+
+using PrometheusLabels = std::vector<std::pair<std::string_view, std::string_view>>;
+
+// Builds a node_exporter textfile-collector (.prom) file
+class PrometheusWriter {
+private:
+    std::string text;
+    std::string last_metric;
+
+    void header(const std::string& name, const std::string& help);
+
+public:
+    // Append a gauge sample; HELP/TYPE are emitted once per metric name
+    void gauge(const std::string& name, const std::string& help,
+               double value, const PrometheusLabels& labels = {});
+
+    const std::string& str() const { return text; }
+
+    // Write through a temporary file and rename it over path
+    bool writeTo(const std::string& path) const;
+};
+
+// Write a textfile-collector file for the host. The static fields are cached
+// between runs and recollected only after a reboot or a change to their files.
+int exportPrometheus(const std::string& path);
+
+} // namespace kfetch
+
+#endif // PROMETHEUS_H
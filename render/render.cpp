@@ -0,0 +1,209 @@
+#include "libkfetch.h"
+#include "distros.h"
+#include "logopack/logopack.h"
+#include "image/image.h"
+#include "width.h"
+#include "numfmt.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kfetch {
+
+static void pad(std::ostream& out, size_t count, char fill = ' ') {
+    std::fill_n(std::ostreambuf_iterator<char>(out), count, fill);
+}
+
+// One block per core, taller and redder with its load; beyond HEAT_CELLS
+// cores each block stands for a run of them and shows the busiest, so a
+// single pegged core still stands out
+template <typename String>
+static void appendHeatBar(String& out, std::span<const float> percent) {
+    constexpr size_t HEAT_CELLS = 64;
+    static constexpr std::string_view blocks[] = {"▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+    size_t group = (percent.size() + HEAT_CELLS - 1) / HEAT_CELLS;
+    std::string_view color;
+    for (size_t start = 0; start < percent.size(); start += group) {
+        float hottest = *std::max_element(percent.begin() + start,
+                                          percent.begin() + std::min(start + group, percent.size()));
+        std::string_view cell_color = hottest < 50 ? "\033[32m" : hottest < 80 ? "\033[33m" : "\033[31m";
+        if (cell_color != color) out += color = cell_color;
+        out += blocks[std::min<size_t>(std::size(blocks) - 1, static_cast<size_t>(hottest * std::size(blocks) / 100))];
+    }
+    out += RESET_COLOR;
+}
+
+void render(const Info& info, const Config& config, std::ostream& out) {
+    LogoPack pack(config.logo_pack.empty() ? defaultLogoPackPath() : config.logo_pack);
+    std::optional<DistroArt> custom_art = pack.find(info.distro_name);
+    const DistroArt& art = custom_art ? *custom_art : getDistroArt(info.distro_name);
+
+    // Everything built here is dropped on return, so it all comes from one
+    // stack arena (spilling to the heap only for unusually long output)
+    std::array<std::byte, 8192> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+
+    // Use custom art color if specified
+    std::pmr::string art_color(config.custom_art_color.empty() ? art.color_code : config.custom_art_color, &arena);
+
+    auto colored = [&](std::string_view text) {
+        std::pmr::string line(art_color, &arena);
+        line += text;
+        line += RESET_COLOR;
+        return line;
+    };
+
+    // Info lines as pairs: {label, value}
+    std::pmr::vector<std::pair<std::pmr::string, std::pmr::string>> info_pairs(&arena);
+
+    // Title line (username@hostname) underlined with dashes
+    auto title = [&](std::string_view text) {
+        info_pairs.emplace_back("", colored(text));
+        info_pairs.emplace_back("", colored(std::pmr::string(displayWidth(text), '-', &arena)));
+    };
+    if (config.show_username && config.show_hostname) {
+        std::pmr::string user_host(info.username, &arena);
+        user_host += '@';
+        user_host += info.hostname;
+        title(user_host);
+    } else if (config.show_username) {
+        title(info.username);
+    } else if (config.show_hostname) {
+        title(info.hostname);
+    }
+
+    if (config.show_os) info_pairs.emplace_back("OS: ", info.distro_pretty_name);
+    if (config.show_kernel) info_pairs.emplace_back("Kernel: ", info.kernel);
+    if (config.show_uptime) info_pairs.emplace_back("Uptime: ", info.uptime);
+    if (config.show_packages) info_pairs.emplace_back("Packages: ", info.packages);
+    if (config.show_shell) info_pairs.emplace_back("Shell: ", info.shell);
+    if (config.show_de) info_pairs.emplace_back("DE/WM: ", info.desktop_env);
+    if (config.show_terminal) info_pairs.emplace_back("Terminal: ", info.terminal);
+    if (config.show_cpu) info_pairs.emplace_back("CPU: ", info.cpu);
+    if (config.show_cpu_load && !info.core_load_percent.empty()) {
+        auto& [label, value] = info_pairs.emplace_back("CPU Load: ", "");
+        appendNumber(value, static_cast<unsigned>(info.cpu_load_percent + 0.5f));
+        value += "% ";
+        appendHeatBar(value, info.core_load_percent);
+    }
+    if (config.show_memory) info_pairs.emplace_back("Memory: ", info.memory);
+    if (config.show_swap && !info.swap.empty()) info_pairs.emplace_back("Swap: ", info.swap);
+    if (config.show_numa) {
+        for (const auto& node : info.memory_nodes) {
+            auto& [label, value] = info_pairs.emplace_back();
+            label += "Node ";
+            appendNumber(label, node.node);
+            label += ": ";
+            appendUsage(value, node.used_bytes, node.total_bytes);
+        }
+    }
+    if (config.show_disk) {
+        for (const auto& disk : info.disks) {
+            auto& [label, value] = info_pairs.emplace_back();
+            label += "Disk (";
+            label += disk.mount_point;
+            label += "): ";
+            if (!disk.responsive) {
+                value += "(unresponsive)";
+                continue;
+            }
+            // Percent of the space users can fill, rounded up, as df prints it
+            uint64_t usable = disk.used_bytes + disk.available_bytes;
+            appendBytes(value, disk.used_bytes);
+            value += " / ";
+            appendBytes(value, disk.total_bytes);
+            value += " (";
+            appendNumber(value, usable ? (disk.used_bytes * 100 + usable - 1) / usable : 0);
+            value += "%)";
+        }
+    }
+    if (config.show_network && !info.network.empty()) info_pairs.emplace_back("Network: ", info.network);
+    info_pairs.emplace_back("GPU: ", info.gpu);
+
+    // Color blocks if enabled
+    if (config.show_colors) {
+        info_pairs.emplace_back();
+        std::pmr::string& color_blocks = info_pairs.emplace_back().second;
+        for (char i = '0'; i < '8'; i++) {
+            color_blocks += "\033[4";
+            color_blocks += i;
+            color_blocks += "m   ";
+        }
+        color_blocks += RESET_COLOR;
+    }
+
+    // An image logo is a fixed image_cols x image_rows cell block: reserve
+    // its rows (scrolling now rather than mid-image), draw it at the top
+    // left without moving the cursor, then skip its columns on every line
+    std::string image;
+    if (config.show_art && !config.image_logo.empty()) {
+        image = encodedImageLogo(config.image_logo, imageProtocol(config.image_protocol),
+                                 config.image_cols, config.image_rows);
+        // A missing file, a format the protocol cannot take (PNG over
+        // Sixel) or no protocol at all: the ASCII logo stands in
+        if (image.empty() && config.verbose_output) {
+            std::cerr << "Render: cannot draw " << config.image_logo << ", showing the ASCII logo\n";
+        }
+    }
+    std::pmr::string skip_image("\033[", &arena);
+    appendNumber(skip_image, config.image_cols + 2);
+    skip_image += 'C';
+
+    size_t art_lines = !config.show_art ? 0 : !image.empty() ? config.image_rows : art.height;
+    size_t max_lines = std::max(art_lines, info_pairs.size());
+
+    if (!image.empty()) {
+        pad(out, max_lines, '\n');
+        out << "\033[" << max_lines << "A";
+        out << "\0337" << image << "\0338";
+    }
+
+    for (size_t i = 0; i < max_lines; i++) {
+        // Print ASCII art line
+        if (!image.empty()) {
+            if (i < info_pairs.size()) out << skip_image;
+        } else if (config.show_art) {
+            if (i < art.height) {
+                out << art_color << art.lines[i] << RESET_COLOR;
+                pad(out, art.width - art.line_widths[i]);
+            } else {
+                pad(out, art.width);
+            }
+            out << "  "; // spacing
+        }
+
+        // Print info line with distro-colored label
+        if (i < info_pairs.size()) {
+            const auto& [label, value] = info_pairs[i];
+
+            if (!label.empty()) {
+                out << art_color << label << RESET_COLOR;
+            }
+
+            // Value can use custom text color or default
+            if (!config.custom_text_color.empty()) {
+                out << config.custom_text_color;
+            }
+
+            out << value;
+
+            if (!config.custom_text_color.empty()) {
+                out << RESET_COLOR;
+            }
+        }
+
+        out << "\n";
+    }
+    out.flush();
+}
+
+} // namespace kfetch
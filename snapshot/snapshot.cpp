@@ -0,0 +1,181 @@
+#include "snapshot.h"
+#include <bit>
+
+namespace kfetch {
+
+// Copy the members owned by the fields in mask
+static void assignFields(Info& to, const Info& from, FieldMask mask) {
+    if (mask & FIELD_OS) {
+        to.distro_name = from.distro_name;
+        to.distro_pretty_name = from.distro_pretty_name;
+    }
+    if (mask & FIELD_HOSTNAME) to.hostname = from.hostname;
+    if (mask & FIELD_USERNAME) to.username = from.username;
+    if (mask & FIELD_KERNEL) to.kernel = from.kernel;
+    if (mask & FIELD_UPTIME) {
+        to.uptime = from.uptime;
+        to.uptime_seconds = from.uptime_seconds;
+    }
+    if (mask & FIELD_PACKAGES) {
+        to.packages = from.packages;
+        to.package_counts = from.package_counts;
+    }
+    if (mask & FIELD_SHELL) to.shell = from.shell;
+    if (mask & FIELD_DE) to.desktop_env = from.desktop_env;
+    if (mask & FIELD_TERMINAL) to.terminal = from.terminal;
+    if (mask & FIELD_CPU) to.cpu = from.cpu;
+    if (mask & FIELD_GPU) {
+        to.gpu = from.gpu;
+        to.gpu_driver = from.gpu_driver;
+    }
+    if (mask & FIELD_MEMORY) {
+        to.memory = from.memory;
+        to.memory_used_bytes = from.memory_used_bytes;
+        to.memory_total_bytes = from.memory_total_bytes;
+        to.memory_available_bytes = from.memory_available_bytes;
+        to.shmem_bytes = from.shmem_bytes;
+        to.hugepages_used_bytes = from.hugepages_used_bytes;
+        to.hugepages_total_bytes = from.hugepages_total_bytes;
+        to.swap = from.swap;
+        to.swap_used_bytes = from.swap_used_bytes;
+        to.swap_total_bytes = from.swap_total_bytes;
+    }
+    if (mask & FIELD_MEMORY_NODES) to.memory_nodes = from.memory_nodes;
+    if (mask & FIELD_DISKS) to.disks = from.disks;
+    if (mask & FIELD_NETWORK) {
+        to.network = from.network;
+        to.network_interface = from.network_interface;
+        to.network_ipv4 = from.network_ipv4;
+        to.network_ipv6 = from.network_ipv6;
+        to.network_speed_mbps = from.network_speed_mbps;
+    }
+    if (mask & FIELD_CPU_LOAD) {
+        to.cpu_load_percent = from.cpu_load_percent;
+        to.core_load_percent = from.core_load_percent;
+    }
+    to.fields |= from.fields & mask;
+}
+
+SnapshotStore::SnapshotStore(FieldMask fields) : fields(fields) {
+    slots[0] = std::make_shared<const Info>();
+    intervals[std::countr_zero(static_cast<uint32_t>(FIELD_UPTIME))] = std::chrono::seconds(1);
+    intervals[std::countr_zero(static_cast<uint32_t>(FIELD_MEMORY))] = std::chrono::seconds(1);
+    intervals[std::countr_zero(static_cast<uint32_t>(FIELD_MEMORY_NODES))] = std::chrono::seconds(1);
+    intervals[std::countr_zero(static_cast<uint32_t>(FIELD_DISKS))] = std::chrono::seconds(10);
+    intervals[std::countr_zero(static_cast<uint32_t>(FIELD_NETWORK))] = std::chrono::seconds(10);
+    intervals[std::countr_zero(static_cast<uint32_t>(FIELD_CPU_LOAD))] = std::chrono::seconds(1);
+}
+
+SnapshotStore::~SnapshotStore() {
+    stop();
+}
+
+void SnapshotStore::setRefreshInterval(Field field, Interval interval) {
+    {
+        std::lock_guard lock(mutex);
+        intervals[std::countr_zero(static_cast<uint32_t>(field))] = interval;
+    }
+    wake.notify_one();
+}
+
+std::shared_ptr<const Info> SnapshotStore::current() const {
+    for (;;) {
+        unsigned slot = active.load();
+        readers[slot].fetch_add(1);
+        // Still the published slot after announcing ourselves, so the
+        // updater cannot be rewriting it until we are done
+        if (active.load() == slot) {
+            std::shared_ptr<const Info> copy = slots[slot];
+            readers[slot].fetch_sub(1, std::memory_order_release);
+            return copy;
+        }
+        readers[slot].fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void SnapshotStore::publish(std::shared_ptr<const Info> next) {
+    unsigned spare = active.load() ^ 1;
+    // Readers hold a slot only while they copy a shared_ptr out of it. This
+    // load and current()'s are sequentially consistent: a reader that is
+    // not counted here is bound to see the flip that retired its slot.
+    while (readers[spare].load() != 0) std::this_thread::yield();
+    slots[spare] = std::move(next);
+    active.store(spare);
+}
+
+// Collect mask and publish it over the current snapshot
+void SnapshotStore::update(FieldMask mask) {
+    Info fresh = collect(mask);
+    auto updated = std::make_shared<Info>(*slots[active.load()]);
+    assignFields(*updated, fresh, mask);
+    publish(std::move(updated));
+}
+
+void SnapshotStore::start() {
+    std::lock_guard lock(mutex);
+    if (updater.joinable()) return;
+    stopping = false;
+    updater = std::thread(&SnapshotStore::run, this);
+}
+
+void SnapshotStore::stop() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (updater.joinable()) updater.join();
+}
+
+void SnapshotStore::run() {
+    using Clock = std::chrono::steady_clock;
+
+    // The first pass publishes the quick fields before the slow ones, so
+    // readers do not wait on lspci, the package scan or the CPU-load window
+    // for the rest. The updater is the only writer, so its own reads of
+    // the published slot need no announcing.
+    constexpr FieldMask SLOW = FIELD_PACKAGES | FIELD_GPU | FIELD_CPU_LOAD | FIELD_DISKS;
+    FieldMask missing = fields & ~slots[active.load()]->fields;
+    if (missing & ~SLOW) update(missing & ~SLOW);
+    if (missing & SLOW) update(missing & SLOW);
+
+    std::unique_lock lock(mutex);
+    // A field is due its interval after it was last refreshed, so a new
+    // interval from setRefreshInterval counts from then, not from the
+    // refresh the old interval had scheduled
+    std::array<Clock::time_point, FIELD_COUNT> refreshed;
+    refreshed.fill(Clock::now());
+
+    while (!stopping) {
+        // Collect every field whose interval has elapsed
+        Clock::time_point now = Clock::now();
+        Clock::time_point next = Clock::time_point::max();
+        FieldMask refresh = 0;
+        for (size_t i = 0; i < FIELD_COUNT; i++) {
+            Field field = static_cast<Field>(1u << i);
+            if (!(fields & field) || intervals[i] == Interval::zero()) continue;
+            Clock::time_point due = refreshed[i] + intervals[i];
+            if (due <= now) {
+                refresh |= field;
+                refreshed[i] = now;
+                due = now + intervals[i];
+            }
+            next = std::min(next, due);
+        }
+
+        if (refresh) {
+            lock.unlock();
+            update(refresh);
+            lock.lock();
+            continue;
+        }
+
+        if (next == Clock::time_point::max()) {
+            wake.wait(lock);
+        } else {
+            wake.wait_until(lock, next);
+        }
+    }
+}
+
+} // namespace kfetch
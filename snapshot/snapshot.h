@@ -0,0 +1,67 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "libkfetch.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace kfetch {
+
+// Shares the current system facts with many threads of a long-running
+// process. A single updater thread collects every field once, the quick
+// ones first, then refreshes the volatile ones, publishing each result as a
+// new immutable Info. Readers copy the published pointer out of one of two
+// slots, retrying only if a publish overtook them: they never take a lock,
+// never wait on a collection and never allocate.
+class SnapshotStore {
+public:
+    using Interval = std::chrono::milliseconds;
+
+    explicit SnapshotStore(FieldMask fields = FIELD_ALL);
+    SnapshotStore(const SnapshotStore&) = delete;
+    SnapshotStore& operator=(const SnapshotStore&) = delete;
+    ~SnapshotStore();
+
+    // Refresh field every interval once the updater runs; a zero interval
+    // (the default for everything but uptime and memory) makes it static
+    void setRefreshInterval(Field field, Interval interval);
+
+    // The latest snapshot. Its fields mask says what is in it: nothing
+    // until the updater's first pass, then the quick fields, then all.
+    std::shared_ptr<const Info> current() const;
+
+    // Start/stop the updater thread. Starting begins the first pass.
+    void start();
+    void stop();
+
+private:
+    static constexpr size_t FIELD_COUNT = 16;
+    static_assert(FIELD_ALL == (1u << FIELD_COUNT) - 1);
+
+    FieldMask fields;
+    std::array<Interval, FIELD_COUNT> intervals{};
+
+    // The published snapshot is slots[active]. The updater writes the other
+    // slot once no reader is still copying out of it, then flips active.
+    std::array<std::shared_ptr<const Info>, 2> slots;
+    std::atomic<unsigned> active{0};
+    mutable std::array<std::atomic<unsigned>, 2> readers{};
+
+    std::mutex mutex;              // Guards intervals and stopping
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread updater;
+
+    void publish(std::shared_ptr<const Info> next);
+    void update(FieldMask mask);
+    void run();
+};
+
+} // namespace kfetch
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,566 @@
+#include "libkfetch.h"
+#include "utils.h"
+#include "gpu/gpu.h"
+#include "cpu/cpu.h"
+#include "cpuload/cpuload.h"
+#include "memory/memory.h"
+#include "disk/disk.h"
+#include "network/network.h"
+#include "procfs/procfs.h"
+#include "kvscan.h"
+#include "numfmt.h"
+#include "packages/packages.h"
+#include <charconv>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cctype>
+#include <unistd.h>
+#include <sys/utsname.h>
+#include <pwd.h>
+#include <cstdlib>
+#include <climits>
+
+// Platform-specific includes
+#ifdef __linux__
+    #include <sys/sysinfo.h>
+#elif defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+    #include <sys/types.h>
+    #include <sys/sysctl.h>
+    #include <sys/time.h>
+    #define BSD_SYSTEM
+#endif
+
+namespace kfetch {
+
+// Runs the collectors, writing their results into an Info
+class SystemInfo {
+private:
+    Info& info;
+
+    // Root filesystem the file-based collectors read from ("" = host)
+    std::string sysroot;
+
+    std::chrono::milliseconds cpu_load_window;
+    std::string cpu_load_state;
+
+    // Threads the package databases may be read on (0 = one each)
+    unsigned jobs;
+
+    // path inside the sysroot, with absolute symlinks kept inside it too
+    std::string rootPath(const std::string& path) const {
+        return resolveUnder(sysroot, path);
+    }
+
+    bool rootExists(const std::string& path) const {
+        return pathExists(rootPath(path).c_str());
+    }
+    
+    void detectDistro() {
+        parseDistro(readPseudoFile(rootPath("/etc/os-release").c_str()));
+    }
+
+    void parseDistro(std::string_view os_release_text) {
+        // Try /etc/os-release first (standard for most modern distros)
+        std::array<std::string_view, 2> os_release;
+        scanKeys(os_release_text, {.separator = '=', .strip_quotes = true}, {"ID", "PRETTY_NAME"}, os_release);
+        info.distro_name = os_release[0];
+        info.distro_pretty_name = os_release[1];
+        
+        // Fallback detection for specific distros
+        if (info.distro_name.empty()) {
+            if (rootExists("/etc/debian_version")) {
+                info.distro_name = "debian";
+                info.distro_pretty_name = "Debian GNU/Linux";
+            } else if (rootExists("/etc/redhat-release")) {
+                std::string_view content = readPseudoFile(rootPath("/etc/redhat-release").c_str());
+                if (content.contains("Fedora")) {
+                    info.distro_name = "fedora";
+                } else if (content.contains("CentOS")) {
+                    info.distro_name = "centos";
+                } else if (content.contains("Red Hat")) {
+                    info.distro_name = "rhel";
+                }
+                info.distro_pretty_name = trimView(content);
+            } else if (rootExists("/etc/arch-release")) {
+                info.distro_name = "arch";
+                info.distro_pretty_name = "Arch Linux";
+            } else if (rootExists("/etc/gentoo-release")) {
+                info.distro_name = "gentoo";
+                info.distro_pretty_name = "Gentoo Linux";
+            } else if (rootExists("/etc/slackware-version")) {
+                info.distro_name = "slackware";
+                info.distro_pretty_name = trimView(readPseudoFile(rootPath("/etc/slackware-version").c_str()));
+            }
+        }
+        
+        // BSD detection (uname describes the host, not a sysroot)
+        struct utsname uts;
+        if (sysroot.empty() && uname(&uts) == 0) {
+            std::string_view sysname = uts.sysname;
+            if (equalsIgnoreCase(sysname, "freebsd")) {
+                info.distro_name = "freebsd";
+                info.distro_pretty_name = "FreeBSD " + std::string(uts.release);
+            } else if (equalsIgnoreCase(sysname, "openbsd")) {
+                info.distro_name = "openbsd";
+                info.distro_pretty_name = "OpenBSD " + std::string(uts.release);
+            } else if (equalsIgnoreCase(sysname, "netbsd")) {
+                info.distro_name = "netbsd";
+                info.distro_pretty_name = "NetBSD " + std::string(uts.release);
+            } else if (equalsIgnoreCase(sysname, "dragonfly")) {
+                info.distro_name = "dragonfly";
+                info.distro_pretty_name = "DragonFly BSD " + std::string(uts.release);
+            }
+        }
+        
+        // Handle special cases and normalize names
+        if (info.distro_name == "linuxmint") info.distro_name = "mint";
+        if (info.distro_name == "popos") info.distro_name = "pop_os";
+        if (info.distro_name == "elementary") info.distro_name = "elementary";
+        if (info.distro_name == "zorin") info.distro_name = "zorin";
+        if (info.distro_name == "kali") info.distro_name = "kali";
+        if (info.distro_name == "parrot") info.distro_name = "parrot";
+        if (info.distro_name == "endeavouros") info.distro_name = "endeavouros";
+        if (info.distro_name == "artixlinux") info.distro_name = "artix";
+        if (info.distro_name == "rocky") info.distro_name = "rocky";
+        if (info.distro_name == "almalinux") info.distro_name = "almalinux";
+        if (info.distro_name == "mxlinux" || info.distro_name == "mx") info.distro_name = "mx";
+        
+        // Convert to lowercase for matching
+        toLowerInPlace(info.distro_name);
+        
+        if (info.distro_pretty_name.empty()) {
+            info.distro_pretty_name = "Unknown System";
+        }
+    }
+    
+    void getHostname() {
+        char buffer[256];
+        if (gethostname(buffer, sizeof(buffer)) == 0) {
+            info.hostname = buffer;
+        }
+    }
+    
+    void getUsername() {
+        struct passwd *pw = getpwuid(getuid());
+        if (pw) {
+            info.username = pw->pw_name;
+        }
+    }
+    
+    void getKernel() {
+        struct utsname uts;
+        if (uname(&uts) == 0) {
+            info.kernel = uts.sysname;
+            info.kernel += ' ';
+            info.kernel += uts.release;
+        }
+    }
+
+    void getGPU() {
+    	kfetch::GPUInfo gpu_info;
+	info.gpu = gpu_info.getFormatted();
+	info.gpu_driver = gpu_info.getDriverVersion();
+    }
+    
+    void getUptime() {
+#ifdef __linux__
+        struct sysinfo si;
+        if (sysinfo(&si) == 0) {
+            long seconds = si.uptime;
+            formatUptime(seconds);
+        }
+#elif defined(BSD_SYSTEM)
+        struct timeval boottime;
+        size_t size = sizeof(boottime);
+        if (kfetch::portable_sysctlbyname("kern.boottime", &boottime, &size, NULL, 0) == 0) {
+            time_t now;
+            time(&now);
+            long seconds = static_cast<long>(difftime(now, boottime.tv_sec));
+            formatUptime(seconds);
+        }
+#else
+        // Fallback: try reading /proc/uptime
+        char buf[128];
+        std::string_view uptime = readPseudoLine("/proc/uptime", buf);
+        long uptimeSeconds = 0;
+        if (std::from_chars(uptime.data(), uptime.data() + uptime.size(), uptimeSeconds).ec == std::errc()) {
+            formatUptime(uptimeSeconds);
+        }
+#endif
+    }
+    
+    void formatUptime(long seconds) {
+        info.uptime_seconds = seconds;
+        info.uptime.clear();
+        appendDuration(info.uptime, info.uptime_seconds);
+    }
+    
+    // Login shell of the current uid in the contents of an /etc/passwd
+    static std::string_view passwdShell(std::string_view content) {
+        char uid[16];
+        std::string_view uid_text(uid, std::to_chars(uid, uid + sizeof(uid), getuid()).ptr);
+        while (!content.empty()) {
+            std::string_view line = content.substr(0, content.find('\n'));
+            content.remove_prefix(std::min(line.size() + 1, content.size()));
+
+            // name:password:uid:gid:gecos:home:shell
+            std::string_view fields[7];
+            size_t count = 0;
+            for (; count < 7 && !line.empty(); count++) {
+                size_t colon = count < 6 ? line.find(':') : std::string_view::npos;
+                fields[count] = line.substr(0, colon);
+                line.remove_prefix(colon == std::string_view::npos ? line.size() : colon + 1);
+            }
+            if (count == 7 && fields[2] == uid_text) return fields[6];
+        }
+        return {};
+    }
+
+    // A sysroot's shell comes from its passwd, with /bin/sh resolved
+    // without leaving the root
+    void parseSysrootShell(std::string_view passwd) {
+        std::string_view shell_path = passwdShell(passwd);
+        if (shell_path.empty()) {
+            info.shell = "Unknown";
+            return;
+        }
+        info.shell = shell_path.substr(shell_path.find_last_of('/') + 1);
+        if (info.shell == "sh") {
+            std::string real_path = rootPath("/bin/sh");
+            std::string_view real_shell = std::string_view(real_path).substr(real_path.find_last_of('/') + 1);
+            if (real_shell != "sh") info.shell = real_shell;
+        }
+    }
+
+    void getShell() {
+    if (!sysroot.empty()) {
+        MappedFile passwd(rootPath("/etc/passwd"));
+        parseSysrootShell(passwd.data() ? std::string_view(passwd.data(), passwd.size()) : std::string_view());
+        return;
+    }
+
+    const char* shell_env = std::getenv("SHELL");
+    if (shell_env) {
+        std::string_view shell_path = shell_env;
+        info.shell = shell_path.substr(shell_path.find_last_of('/') + 1);
+    } else {
+        // Fallback for FreeBSD and other systems
+        struct passwd *pw = getpwuid(getuid());
+        if (pw && pw->pw_shell) {
+            std::string_view shell_path = pw->pw_shell;
+            info.shell = shell_path.substr(shell_path.find_last_of('/') + 1);
+        } else {
+            info.shell = "Unknown";
+        }
+    }
+    
+    // Handle special cases
+    if (info.shell == "bash") info.shell = "bash";
+    else if (info.shell == "zsh") info.shell = "zsh";
+    else if (info.shell == "fish") info.shell = "fish";
+    else if (info.shell == "tcsh") info.shell = "tcsh";
+    else if (info.shell == "csh") info.shell = "csh";
+    else if (info.shell == "ksh") info.shell = "ksh";
+    else if (info.shell == "dash") info.shell = "dash";
+    else if (info.shell == "sh") {
+        // Try to detect actual shell for sh symlink
+        std::string real_shell = executeCommand("readlink -f $(which sh) | xargs basename");
+        if (!real_shell.empty() && real_shell != "sh") {
+            info.shell = real_shell;
+        }
+    }
+}    
+
+    void getDesktopEnvironment() {
+        const char* de = std::getenv("XDG_CURRENT_DESKTOP");
+        if (de) {
+            info.desktop_env = de;
+        } else {
+            de = std::getenv("DESKTOP_SESSION");
+            if (de) {
+                info.desktop_env = de;
+            } else {
+                info.desktop_env = "None (TTY)";
+            }
+        }
+    }
+    
+    void getTerminal() {
+        const char* term = std::getenv("TERM_PROGRAM");
+        if (term) {
+            info.terminal = term;
+        } else {
+            // Try to detect from parent process
+            std::string ppid = executeCommand("ps -o ppid= -p $$");
+            if (!ppid.empty()) {
+                std::string parent = executeCommand("ps -o comm= -p " + ppid);
+                if (!parent.empty()) {
+                    info.terminal = parent;
+                }
+            }
+            
+            if (info.terminal.empty()) {
+                term = std::getenv("TERM");
+                if (term) {
+                    info.terminal = term;
+                }
+            }
+        }
+    }
+    
+    void getCPU() {
+        CPUInfo cpu_info;
+        info.cpu = cpu_info.getFormatted();
+    }
+    
+    void getMemory() {
+#ifndef BSD_SYSTEM
+    // /proc/meminfo: Linux, and other systems emulating it
+    MemoryStats stats;
+    if (readMeminfo(stats)) {
+        info.memory_total_bytes = stats.total_kb * 1024ULL;
+        info.memory_available_bytes = stats.available_kb * 1024ULL;
+        info.memory_used_bytes = info.memory_total_bytes - info.memory_available_bytes;
+        info.shmem_bytes = stats.shmem_kb * 1024ULL;
+        info.hugepages_total_bytes = stats.hugepages_total * stats.hugepage_size_kb * 1024ULL;
+        info.hugepages_used_bytes = (stats.hugepages_total - std::min(stats.hugepages_free, stats.hugepages_total)) *
+                                    stats.hugepage_size_kb * 1024ULL;
+        info.swap_total_bytes = stats.swap_total_kb * 1024ULL;
+        info.swap_used_bytes = (stats.swap_total_kb - std::min(stats.swap_free_kb, stats.swap_total_kb)) * 1024ULL;
+
+        info.memory.clear();
+        appendUsage(info.memory, info.memory_used_bytes, info.memory_total_bytes);
+        if (info.hugepages_total_bytes > 0) {
+            info.memory += " (hugepages ";
+            appendUsage(info.memory, info.hugepages_used_bytes, info.hugepages_total_bytes);
+            info.memory += ')';
+        }
+        if (info.swap_total_bytes > 0) {
+            info.swap.clear();
+            appendUsage(info.swap, info.swap_used_bytes, info.swap_total_bytes);
+        }
+        return;
+    }
+#else
+    uint64_t total_mem;
+    size_t size = sizeof(total_mem);
+
+    if (kfetch::portable_sysctlbyname("hw.physmem", &total_mem, &size, NULL, 0) != 0) {
+        info.memory = "Unknown";
+        return;
+    }
+
+    // 64-bit page info
+    uint64_t free_pages = 0, inactive_pages = 0, cache_pages = 0, pagesize = 4096;
+
+    size = sizeof(pagesize);
+    kfetch::portable_sysctlbyname("hw.pagesize", &pagesize, &size, NULL, 0);
+
+    size = sizeof(free_pages);
+    kfetch::portable_sysctlbyname("vm.stats.vm.v_free_count", &free_pages, &size, NULL, 0);
+
+    size = sizeof(inactive_pages);
+    kfetch::portable_sysctlbyname("vm.stats.vm.v_inactive_count", &inactive_pages, &size, NULL, 0);
+
+    size = sizeof(cache_pages);
+    kfetch::portable_sysctlbyname("vm.stats.vm.v_cache_count", &cache_pages, &size, NULL, 0);
+
+    uint64_t total_mb = total_mem / (1024ULL * 1024ULL);
+    uint64_t available_mb = (free_pages + inactive_pages + cache_pages) * pagesize / (1024ULL * 1024ULL);
+    uint64_t used_mb = (total_mb > available_mb) ? total_mb - available_mb : 0;
+    info.memory_total_bytes = total_mem;
+    info.memory_used_bytes = used_mb * 1024ULL * 1024ULL;
+    info.memory_available_bytes = total_mem - std::min<uint64_t>(total_mem, info.memory_used_bytes);
+
+    info.memory.clear();
+    appendUsage(info.memory, info.memory_used_bytes, info.memory_total_bytes);
+    return;
+#endif
+
+    info.memory = "Unknown";
+}
+
+    void getMemoryNodes() {
+#ifdef __linux__
+    std::vector<MemoryNode> nodes = readNodeMemory();
+    info.memory_nodes.assign(nodes.begin(), nodes.end());
+#endif
+}
+
+    void getDisks() {
+#ifdef __linux__
+    std::vector<Disk> disks = readDisks();
+    info.disks.assign(std::make_move_iterator(disks.begin()), std::make_move_iterator(disks.end()));
+#endif
+}
+
+    void getCpuLoad() {
+    std::vector<float> percent;  // The aggregate, then each CPU
+    if (!measureCpuLoad(cpu_load_window, cpu_load_state, percent)) return;
+    info.cpu_load_percent = percent[0];
+    info.core_load_percent.assign(percent.begin() + 1, percent.end());
+}
+
+    void getNetwork() {
+    NetworkInfo network;
+    if (!readNetwork(network)) return;
+    info.network_interface = network.interface;
+    info.network_ipv4 = network.ipv4;
+    info.network_ipv6 = network.ipv6;
+    info.network_speed_mbps = network.speed_mbps;
+
+    // "eth0: 192.168.1.20/24, 2001:db8::20/64 (2.5 Gbps)"
+    std::pmr::string& line = info.network;
+    line = network.interface;
+    const char* separator = ": ";
+    for (const std::string* address : {&network.ipv4, &network.ipv6}) {
+        if (address->empty()) continue;
+        line += separator;
+        line += *address;
+        separator = ", ";
+    }
+    unsigned mbps = network.speed_mbps;
+    if (mbps > 0) {
+        line += " (";
+        if (mbps < 1000) appendNumber(line, mbps);
+        else if (mbps % 1000 == 0) appendNumber(line, mbps / 1000);
+        else appendDecimal(line, mbps / 100, 1);
+        line += mbps < 1000 ? " Mbps)" : " Gbps)";
+    }
+}
+
+    void getPackages() {
+    // The detectors run on their own threads, so they cannot share the
+    // (unsynchronized) arena; their few results are copied into it here
+    for (auto& [manager, count] : countPackages(sysroot, jobs)) {
+        info.package_counts.emplace_back(manager, count);
+    }
+
+    std::pmr::string& joined = info.packages;
+    for (const auto& [manager, count] : info.package_counts) {
+        if (!joined.empty()) joined += ", ";
+        appendNumber(joined, count);
+        joined += " (";
+        joined += manager;
+        joined += ')';
+    }
+    if (joined.empty()) joined = "Unknown";
+}
+    
+    // Files a field can be parsed from alone, declared up front so that a
+    // whole scan's worth of them goes out as one batch. The buffers live
+    // here because the reads finish only when the batch runs.
+    std::string os_release_path;
+    std::string passwd_path;
+    std::array<char, 8192> os_release_buf;
+    std::array<char, 16384> passwd_buf;
+
+public:
+    SystemInfo(Info& info, const CollectOptions& options)
+        : info(info), sysroot(options.sysroot), cpu_load_window(options.cpu_load_window),
+          cpu_load_state(options.cpu_load_state), jobs(options.jobs) {}
+
+    void declareReads(ReadBatch& batch, FieldMask mask) {
+        mask &= ~info.fields;
+        if (mask & FIELD_OS) {
+            os_release_path = rootPath("/etc/os-release");
+            batch.add(os_release_path.c_str(), os_release_buf, [](void* self, std::string_view content) {
+                static_cast<SystemInfo*>(self)->parseDistro(content);
+                static_cast<SystemInfo*>(self)->info.fields |= FIELD_OS;
+            }, this);
+        }
+        if ((mask & FIELD_SHELL) && !sysroot.empty()) {
+            passwd_path = rootPath("/etc/passwd");
+            batch.add(passwd_path.c_str(), passwd_buf, [](void* self, std::string_view content) {
+                // A full buffer may have cut the file short: getShell maps it whole
+                auto* system = static_cast<SystemInfo*>(self);
+                if (content.size() == system->passwd_buf.size()) return;
+                system->parseSysrootShell(content);
+                system->info.fields |= FIELD_SHELL;
+            }, this);
+        }
+    }
+
+    void run(FieldMask mask) {
+        ReadBatch batch;
+        declareReads(batch, mask);
+        batch.run();
+
+        static constexpr std::pair<Field, void (SystemInfo::*)()> collectors[] = {
+            {FIELD_OS,       &SystemInfo::detectDistro},
+            {FIELD_HOSTNAME, &SystemInfo::getHostname},
+            {FIELD_USERNAME, &SystemInfo::getUsername},
+            {FIELD_KERNEL,   &SystemInfo::getKernel},
+            {FIELD_UPTIME,   &SystemInfo::getUptime},
+            {FIELD_SHELL,    &SystemInfo::getShell},
+            {FIELD_DE,       &SystemInfo::getDesktopEnvironment},
+            {FIELD_TERMINAL, &SystemInfo::getTerminal},
+            {FIELD_CPU,      &SystemInfo::getCPU},
+            {FIELD_CPU_LOAD, &SystemInfo::getCpuLoad},
+            {FIELD_GPU,      &SystemInfo::getGPU},
+            {FIELD_MEMORY,   &SystemInfo::getMemory},
+            {FIELD_MEMORY_NODES, &SystemInfo::getMemoryNodes},
+            {FIELD_DISKS,    &SystemInfo::getDisks},
+            {FIELD_NETWORK,  &SystemInfo::getNetwork},
+            {FIELD_PACKAGES, &SystemInfo::getPackages},
+        };
+
+        for (const auto& [field, collector] : collectors) {
+            if (!(mask & field) || (info.fields & field)) continue;
+            (this->*collector)();
+            info.fields |= field;
+        }
+    }
+};
+
+Info::Info(const allocator_type& alloc)
+    : distro_name(alloc), distro_pretty_name(alloc), hostname(alloc), username(alloc), kernel(alloc),
+      uptime(alloc), shell(alloc), desktop_env(alloc), terminal(alloc), cpu(alloc), gpu(alloc),
+      gpu_driver(alloc), memory(alloc), swap(alloc), packages(alloc), network(alloc),
+      network_interface(alloc), network_ipv4(alloc), network_ipv6(alloc), core_load_percent(alloc),
+      memory_nodes(alloc), disks(alloc), package_counts(alloc) {}
+
+void collect(Info& info, FieldMask mask, const CollectOptions& options) {
+    SystemInfo(info, options).run(mask);
+}
+
+void prefetch(std::span<Info> infos, std::span<const std::string> roots, FieldMask mask) {
+    // In chunks, so the read buffers of a large scan stay bounded
+    constexpr size_t CHUNK = 256;
+    for (size_t start = 0; start < infos.size(); start += CHUNK) {
+        size_t count = std::min(CHUNK, infos.size() - start);
+        std::vector<SystemInfo> systems;
+        systems.reserve(count);
+        ReadBatch batch;
+        for (size_t i = start; i < start + count; i++) {
+            systems.emplace_back(infos[i], CollectOptions{roots[i]}).declareReads(batch, mask);
+        }
+        batch.run();
+    }
+}
+
+FieldMask displayedFields(const Config& config) {
+    FieldMask mask = FIELD_GPU;
+    if (config.show_os) mask |= FIELD_OS;
+    if (config.show_username) mask |= FIELD_USERNAME;
+    if (config.show_hostname) mask |= FIELD_HOSTNAME;
+    if (config.show_kernel) mask |= FIELD_KERNEL;
+    if (config.show_uptime) mask |= FIELD_UPTIME;
+    if (config.show_packages) mask |= FIELD_PACKAGES;
+    if (config.show_shell) mask |= FIELD_SHELL;
+    if (config.show_de) mask |= FIELD_DE;
+    if (config.show_terminal) mask |= FIELD_TERMINAL;
+    if (config.show_cpu) mask |= FIELD_CPU;
+    if (config.show_cpu_load) mask |= FIELD_CPU_LOAD;
+    if (config.show_memory || config.show_swap) mask |= FIELD_MEMORY;
+    if (config.show_numa) mask |= FIELD_MEMORY_NODES;
+    if (config.show_disk) mask |= FIELD_DISKS;
+    if (config.show_network) mask |= FIELD_NETWORK;
+    // The logo is picked by distro ID
+    if (config.show_art) mask |= FIELD_OS;
+    return mask;
+}
+
+} // namespace kfetch
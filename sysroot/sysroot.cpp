@@ -0,0 +1,70 @@
+#include "sysroot.h"
+#include "utils.h"
+#include <iostream>
+#include <sstream>
+#include <glob.h>
+#include <sys/stat.h>
+
+namespace kfetch {
+
+std::vector<std::string> expandRoots(const std::vector<std::string>& patterns) {
+    std::vector<std::string> roots;
+
+    for (const auto& pattern : patterns) {
+        glob_t matches{};
+        if (glob(pattern.c_str(), GLOB_ONLYDIR, nullptr, &matches) == 0) {
+            for (size_t i = 0; i < matches.gl_pathc; i++) {
+                std::string root = matches.gl_pathv[i];
+                struct stat st;
+                if (stat(root.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) continue;
+
+                while (root.size() > 1 && root.back() == '/') root.pop_back();
+                if (root == "/") root.clear();
+                roots.push_back(root);
+            }
+        }
+        globfree(&matches);
+    }
+
+    return roots;
+}
+
+int scanRoots(const Config& config) {
+    std::vector<std::string> roots = expandRoots(config.roots);
+    if (roots.empty()) {
+        std::cerr << "kfetch: no directory matches --root\n";
+        return 1;
+    }
+
+    Info host = collect(FIELD_KERNEL | FIELD_CPU | FIELD_MEMORY);
+    std::cout << "[host]\n"
+              << "kernel = " << host.kernel << "\n"
+              << "cpu = " << host.cpu << "\n"
+              << "memory = " << host.memory << "\n";
+
+    // os-release and passwd of every root in one batch, the package
+    // databases root by root on the pool
+    std::vector<Info> infos(roots.size());
+    prefetch(infos, roots, FIELDS_SYSROOT);
+
+    std::vector<std::string> records(roots.size());
+    parallelFor(roots.size(), [&](size_t i) {
+        Info& info = infos[i];
+        // The roots already fill the pool, so each reads its package
+        // databases on its own thread
+        collect(info, FIELDS_SYSROOT, {.sysroot = roots[i], .jobs = 1});
+
+        std::ostringstream record;
+        record << "\n[" << (roots[i].empty() ? "/" : roots[i]) << "]\n"
+               << "distro = " << info.distro_name << "\n"
+               << "os = " << info.distro_pretty_name << "\n"
+               << "packages = " << info.packages << "\n"
+               << "shell = " << info.shell << "\n";
+        records[i] = record.str();
+    }, config.jobs);
+
+    for (const auto& record : records) std::cout << record;
+    return 0;
+}
+
+} // namespace kfetch
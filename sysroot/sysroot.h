@@ -0,0 +1,20 @@
+#ifndef SYSROOT_H
+#define SYSROOT_H
+
+#include "libkfetch.h"
+#include <string>
+#include <vector>
+
+namespace kfetch {
+
+// Expand --root arguments (paths or glob patterns) into existing directories,
+// without trailing slashes and in argument order
+std::vector<std::string> expandRoots(const std::vector<std::string>& patterns);
+
+// Collect every config.roots entry concurrently and print one record per
+// root, after a shared [host] record with the kernel, CPU and memory
+int scanRoots(const Config& config);
+
+} // namespace kfetch
+
+#endif // SYSROOT_H
@@ -0,0 +1,41 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <iostream>
+#include <string_view>
+
+// The smallest test harness that will do: CHECK and CHECK_EQ report the
+// failing line and carry on, and main returns checkResult() so make test
+// stops at the first test binary with a failure.
+
+inline int check_failures = 0;
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            check_failures++;                                                            \
+        }                                                                                \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                         \
+    do {                                                                                   \
+        const auto& check_actual = (actual);                                               \
+        const auto& check_expected = (expected);                                           \
+        if (!(check_actual == check_expected)) {                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #actual " is \"" << check_actual \
+                      << "\", expected \"" << check_expected << "\"\n";                    \
+            check_failures++;                                                              \
+        }                                                                                  \
+    } while (0)
+
+inline int checkResult(std::string_view name) {
+    if (check_failures) {
+        std::cerr << name << ": " << check_failures << " failed\n";
+        return 1;
+    }
+    std::cout << name << ": ok\n";
+    return 0;
+}
+
+#endif // CHECK_H
@@ -0,0 +1,88 @@
+#include "disk/disk.h"
+#include "check.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kfetch;
+
+// Mount points selectMounts keeps, decoded, in order
+static std::vector<std::string> selected(std::string_view mountinfo) {
+    std::vector<std::string> points;
+    for (const MountEntry& entry : selectMounts(mountinfo)) points.push_back(unescapeMountPoint(entry.mount_point));
+    return points;
+}
+
+static void testUnescape() {
+    CHECK_EQ(unescapeMountPoint("/mnt/usb\\040stick"), "/mnt/usb stick");
+    CHECK_EQ(unescapeMountPoint("/a\\011b\\012c\\134d"), "/a\tb\nc\\d");
+    // Not a full three-digit octal escape: kept as it is
+    CHECK_EQ(unescapeMountPoint("/odd\\04"), "/odd\\04");
+    CHECK_EQ(unescapeMountPoint("/odd\\089"), "/odd\\089");
+    CHECK_EQ(unescapeMountPoint("/plain"), "/plain");
+}
+
+static void testFilters() {
+    CHECK(isPseudoFilesystem("proc"));
+    CHECK(isPseudoFilesystem("tmpfs"));
+    CHECK(isPseudoFilesystem("overlay"));
+    CHECK(!isPseudoFilesystem("ext4"));
+    CHECK(!isPseudoFilesystem("nfs4"));
+
+    // Pseudo filesystems and the system's own directories are dropped,
+    // but not a directory that only shares a prefix with one
+    std::string mountinfo =
+        "22 1 0:21 / /proc rw - proc proc rw\n"
+        "23 1 0:22 / /sys rw - sysfs sysfs rw\n"
+        "24 1 0:5 / /dev rw - devtmpfs udev rw\n"
+        "25 24 0:23 / /dev/shm rw - tmpfs tmpfs rw\n"
+        "26 1 8:1 / / rw shared:1 - ext4 /dev/sda1 rw\n"
+        "27 1 8:3 /hostname /etc/hostname rw - ext4 /dev/sda3 rw\n"
+        "28 1 0:24 / /run rw - tmpfs tmpfs rw\n"
+        "29 1 8:2 / /devices rw - xfs /dev/sda2 rw\n"
+        "30 1 0:40 / /mnt/nfs rw - nfs4 server:/export rw\n"
+        "31 1 0:41 / /var/lib/docker/overlay rw - overlay overlay rw\n"
+        "malformed line\n";
+    CHECK(selected(mountinfo) == (std::vector<std::string>{"/", "/devices", "/mnt/nfs"}));
+}
+
+static void testDedup() {
+    // btrfs gives every subvolume its own anonymous device number, so its
+    // mounts are known by the block device: /home is the same filesystem
+    // as /. A bind mount repeats the device number.
+    std::string mountinfo =
+        "26 1 0:30 /@ / rw - btrfs /dev/nvme0n1p2 rw,subvol=/@\n"
+        "27 26 0:31 /@home /home rw - btrfs /dev/nvme0n1p2 rw,subvol=/@home\n"
+        "28 26 259:1 / /boot rw - vfat /dev/nvme0n1p1 rw\n"
+        "29 26 0:40 / /srv/share rw - nfs4 server:/share rw\n"
+        "30 26 0:40 / /mnt/share\\040again rw - nfs4 server:/share rw\n"
+        "31 26 8:17 / /mnt/usb\\040stick rw - ext4 /dev/sdb1 rw\n";
+    CHECK(selected(mountinfo) == (std::vector<std::string>{"/", "/boot", "/srv/share", "/mnt/usb stick"}));
+}
+
+static void testRoot() {
+    // The last mount on "/" is the one in effect, and it comes first
+    std::string mountinfo =
+        "20 0 8:1 / /data rw - ext4 /dev/sda1 rw\n"
+        "21 0 0:2 / / rw - rootfs rootfs rw\n"
+        "22 21 8:2 / / rw - ext4 /dev/sda2 rw\n";
+    std::vector<MountEntry> mounts = selectMounts(mountinfo);
+    CHECK_EQ(mounts.size(), size_t{2});
+    if (mounts.size() != 2) return;
+    CHECK_EQ(mounts[0].mount_point, "/");
+    CHECK_EQ(mounts[0].source, "/dev/sda2");
+    CHECK_EQ(mounts[0].fs_type, "ext4");
+    CHECK_EQ(mounts[1].mount_point, "/data");
+
+    // No root mount at all (a chroot's view) still lists the rest
+    CHECK(selected("20 0 8:1 / /data rw - ext4 /dev/sda1 rw\n") == std::vector<std::string>{"/data"});
+    CHECK(selectMounts("").empty());
+}
+
+int main() {
+    testUnescape();
+    testFilters();
+    testDedup();
+    testRoot();
+    return checkResult("disk");
+}
@@ -0,0 +1,22 @@
+-- Builds tests/fixtures/root/usr/lib/sysimage/rpm/rpmdb.sqlite and its WAL:
+--   cd tests/fixtures/root/usr/lib/sysimage/rpm && sqlite3 < ../../../../../rpmdb.sql
+-- 200 rows in the main file across a two-level B-tree, then two
+-- transactions left in the WAL: 20 rows, and 100 larger rows spanning
+-- several frames. The copies are taken while the WAL is still open, as
+-- a running rpm would leave them.
+.open build.sqlite
+PRAGMA page_size = 1024;
+-- A schema entry too long for its page, so its sql spills to overflow
+CREATE TABLE Config (key TEXT PRIMARY KEY, value TEXT, CHECK (length(key) < 1000 AND key NOT IN ('aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa', 'bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb', 'cccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccccc', 'dddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddddd', 'eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee', 'ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff', 'gggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggggg', 'hhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhh', 'iiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiiii', 'jjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjjj')));
+CREATE TABLE Packages (hnum INTEGER PRIMARY KEY AUTOINCREMENT, blob BLOB NOT NULL);
+WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 200)
+INSERT INTO Packages (blob) SELECT randomblob(100) FROM n;
+PRAGMA journal_mode = WAL;
+PRAGMA wal_autocheckpoint = 0;
+WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 20)
+INSERT INTO Packages (blob) SELECT randomblob(100) FROM n;
+WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 100)
+INSERT INTO Packages (blob) SELECT randomblob(300) FROM n;
+.system cp build.sqlite rpmdb.sqlite && cp build.sqlite-wal rpmdb.sqlite-wal
+.open :memory:
+.system rm -f build.sqlite build.sqlite-wal build.sqlite-shm
@@ -0,0 +1,18 @@
+-- Builds tests/fixtures/rpm64k/rpmdb.sqlite:
+--   cd tests/fixtures/rpm64k && sqlite3 < ../rpmdb64k.sql
+-- 64 KiB pages, which the header stores as 1. The schema entry ahead of
+-- Packages is longer than a whole page, so its sql spills to overflow
+-- pages. Packages holds 700 small rows across an interior page and its
+-- leaves, plus 2 rows too large for a page of their own (zeros, so the
+-- file compresses well in git).
+.open rpmdb.sqlite
+PRAGMA page_size = 65536;
+.once schema.sql
+SELECT 'CREATE TABLE Config (key TEXT PRIMARY KEY, value TEXT, CHECK (key <> ''' || hex(zeroblob(40000)) || '''));';
+.read schema.sql
+.system rm -f schema.sql
+CREATE TABLE Packages (hnum INTEGER PRIMARY KEY AUTOINCREMENT, blob BLOB NOT NULL);
+WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 700)
+INSERT INTO Packages (blob) SELECT randomblob(100) FROM n;
+WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 2)
+INSERT INTO Packages (blob) SELECT zeroblob(70000) FROM n;
@@ -0,0 +1,74 @@
+#include "numfmt.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+using namespace kfetch;
+
+// ns per line for the stream formatting numfmt.h replaced and for the
+// helpers, each building a fresh string as the collectors do
+
+constexpr int ITERATIONS = 1000000;
+
+template <typename Format>
+static double nsPerCall(Format format) {
+    size_t total = 0;  // Keeps the loop from being optimized away
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) total += format(static_cast<uint64_t>(i)).size();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (total == 0) std::puts("");
+    return elapsed.count() / ITERATIONS;
+}
+
+static std::string streamUptime(uint64_t seconds) {
+    uint64_t days = seconds / 86400, hours = seconds % 86400 / 3600, minutes = seconds % 3600 / 60;
+    std::stringstream ss;
+    if (days > 0) ss << days << " day" << (days > 1 ? "s" : "") << ", ";
+    if (hours > 0) ss << hours << " hour" << (hours > 1 ? "s" : "") << ", ";
+    ss << minutes << " min" << (minutes > 1 ? "s" : "");
+    return ss.str();
+}
+
+static std::string streamUsage(uint64_t used_mb, uint64_t total_mb) {
+    std::stringstream ss;
+    ss << used_mb << " MB / " << total_mb << " MB";
+    return ss.str();
+}
+
+int main() {
+    constexpr uint64_t uptime = 3 * 86400 + 4 * 3600;
+    constexpr uint64_t total = uint64_t{16} << 30;
+    auto report = [](const char* line, double before, double after) {
+        std::printf("%-12s stringstream %6.1f ns  numfmt %6.1f ns\n", line, before, after);
+    };
+
+    report("uptime",
+           nsPerCall([](uint64_t i) { return streamUptime(uptime + i * 60); }),
+           nsPerCall([](uint64_t i) {
+               std::string out;
+               appendDuration(out, uptime + i * 60);
+               return out;
+           }));
+    report("memory",
+           nsPerCall([](uint64_t i) { return streamUsage(i & 0x3fff, total >> 20); }),
+           nsPerCall([](uint64_t i) {
+               std::string out;
+               appendUsage(out, (i & 0x3fff) << 20, total);
+               return out;
+           }));
+    report("disk",
+           nsPerCall([](uint64_t i) {
+               std::ostringstream oss;
+               oss.precision(1);
+               oss << std::fixed << static_cast<double>(total + (i << 20)) / (1 << 30) << " GiB";
+               return oss.str();
+           }),
+           nsPerCall([](uint64_t i) {
+               std::string out;
+               appendBytes(out, total + (i << 20));
+               return out;
+           }));
+    return 0;
+}
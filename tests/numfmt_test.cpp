@@ -0,0 +1,168 @@
+#include "numfmt.h"
+#include "check.h"
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+
+using namespace kfetch;
+
+// The stream and to_string formatting numfmt.h replaced; its output is
+// what the helpers must keep printing
+
+static std::string oldDuration(uint64_t seconds) {
+    int days = seconds / 86400;
+    int hours = (seconds % 86400) / 3600;
+    int minutes = (seconds % 3600) / 60;
+
+    std::stringstream ss;
+    if (days > 0) {
+        ss << days << " day" << (days > 1 ? "s" : "") << ", ";
+    }
+    if (hours > 0) {
+        ss << hours << " hour" << (hours > 1 ? "s" : "") << ", ";
+    }
+    ss << minutes << " min" << (minutes > 1 ? "s" : "");
+    return ss.str();
+}
+
+static std::string oldUsage(uint64_t used_bytes, uint64_t total_bytes) {
+    return std::to_string(used_bytes >> 20) + " MB / " + std::to_string(total_bytes >> 20) + " MB";
+}
+
+static std::string oldBytes(uint64_t bytes) {
+    const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB"};
+    double size = static_cast<double>(bytes);
+    int unit = 0;
+    while (size >= 1024 && unit < 6) {
+        size /= 1024;
+        unit++;
+    }
+    std::ostringstream oss;
+    if (unit == 0) {
+        oss << bytes << " " << units[unit];
+    } else {
+        oss << std::fixed << std::setprecision(1) << size << " " << units[unit];
+    }
+    return oss.str();
+}
+
+static std::string oldFixed(double value, int precision) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", precision, value);
+    return buf;
+}
+
+template <typename Append>
+static std::string format(Append append) {
+    std::string out;
+    append(out);
+    return out;
+}
+
+static void testNumber() {
+    static constexpr int64_t values[] = {0, 1, -1, 9, 10, 99, 100, 65535, INT32_MAX, INT32_MIN, INT64_MAX, INT64_MIN};
+    for (int64_t value : values) {
+        CHECK_EQ(format([&](auto& out) { appendNumber(out, value); }), std::to_string(value));
+    }
+    CHECK_EQ(format([](auto& out) { appendNumber(out, UINT64_MAX); }), std::to_string(UINT64_MAX));
+    CHECK_EQ(format([](auto& out) { appendNumber(out, static_cast<unsigned char>(200)); }), "200");
+
+    // Appends to what is there, in a pmr string too
+    std::pmr::string pmr = "Node ";
+    appendNumber(pmr, 3u);
+    CHECK_EQ(std::string(pmr), "Node 3");
+}
+
+static void testFixed() {
+    static constexpr struct {
+        double value;
+        int precision;
+    } cases[] = {
+        {0.0, 1}, {0.05, 1}, {0.25, 1}, {1.0, 0}, {1.5, 0}, {2.5, 0}, {3.14159, 2}, {-3.14159, 3},
+        {1023.95, 1}, {1e15, 2}, {123456.789, 4}, {0.001, 2},
+    };
+    for (const auto& [value, precision] : cases) {
+        CHECK_EQ(format([&](auto& out) { appendFixed(out, value, precision); }), oldFixed(value, precision));
+    }
+    for (int i = 0; i < 20000; i++) {
+        double value = i * 0.0137 - 50;
+        CHECK_EQ(format([&](auto& out) { appendFixed(out, value, 1); }), oldFixed(value, 1));
+    }
+    // Too long for fixed: %g-style instead of nothing
+    CHECK_EQ(format([](auto& out) { appendFixed(out, 1e300, 2); }), "1e+300");
+}
+
+static void testDecimal() {
+    static constexpr struct {
+        int64_t scaled;
+        unsigned decimals;
+        const char* expected;
+    } cases[] = {
+        {370, 2, "3.70"}, {5, 2, "0.05"}, {0, 2, "0.00"}, {-5, 2, "-0.05"}, {-370, 2, "-3.70"},
+        {42, 0, "42"}, {1234567, 3, "1234.567"}, {INT64_MIN, 2, "-92233720368547758.08"},
+    };
+    for (const auto& [scaled, decimals, expected] : cases) {
+        CHECK_EQ(format([&](auto& out) { appendDecimal(out, scaled, decimals); }), expected);
+    }
+}
+
+static void testBytes() {
+    static constexpr struct {
+        uint64_t bytes;
+        const char* expected;
+    } cases[] = {
+        {0, "0 B"}, {1023, "1023 B"}, {1024, "1.0 KiB"}, {1536, "1.5 KiB"},
+        {uint64_t{1} << 20, "1.0 MiB"}, {(uint64_t{1} << 20) - 1, "1024.0 KiB"},
+        {uint64_t{17} << 30, "17.0 GiB"}, {uint64_t{1} << 60, "1.0 EiB"}, {UINT64_MAX, "16.0 EiB"},
+    };
+    for (const auto& [bytes, expected] : cases) {
+        CHECK_EQ(format([&](auto& out) { appendBytes(out, bytes); }), expected);
+    }
+    // Below 2^53 every byte count is exact as a double, as the old code needed
+    for (uint64_t bytes = 1; bytes < (uint64_t{1} << 53); bytes = bytes * 3 + 7) {
+        CHECK_EQ(format([&](auto& out) { appendBytes(out, bytes); }), oldBytes(bytes));
+    }
+    CHECK_EQ(format([](auto& out) { appendBytes(out, uint64_t{3} << 29, 2); }), "1.50 GiB");
+}
+
+static void testUsage() {
+    static constexpr uint64_t sizes[] = {0, 1, (1 << 20) - 1, 1 << 20, uint64_t{15} << 30, UINT64_MAX};
+    for (uint64_t used : sizes) {
+        for (uint64_t total : sizes) {
+            CHECK_EQ(format([&](auto& out) { appendUsage(out, used, total); }), oldUsage(used, total));
+        }
+    }
+    CHECK_EQ(format([](auto& out) { appendUsage(out, uint64_t{1536} << 20, uint64_t{8} << 30); }),
+             "1536 MB / 8192 MB");
+}
+
+static void testDuration() {
+    static constexpr struct {
+        uint64_t seconds;
+        const char* expected;
+    } cases[] = {
+        {0, "0 min"}, {59, "0 min"}, {60, "1 min"}, {120, "2 mins"}, {3600, "1 hour, 0 min"},
+        {3660, "1 hour, 1 min"}, {86400, "1 day, 0 min"}, {2 * 86400 + 3 * 3600 + 4 * 60, "2 days, 3 hours, 4 mins"},
+    };
+    for (const auto& [seconds, expected] : cases) {
+        CHECK_EQ(format([&](auto& out) { appendDuration(out, seconds); }), expected);
+    }
+    // Every minute of the first 400 days
+    for (uint64_t seconds = 0; seconds < 400 * 86400; seconds += 60) {
+        CHECK_EQ(format([&](auto& out) { appendDuration(out, seconds); }), oldDuration(seconds));
+    }
+}
+
+int main() {
+    testNumber();
+    testFixed();
+    testDecimal();
+    testBytes();
+    testUsage();
+    testDuration();
+    return checkResult("numfmt");
+}
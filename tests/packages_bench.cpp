@@ -0,0 +1,70 @@
+#include "packages/packages.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+using namespace kfetch;
+
+// ms and GB/s for counting a synthetic 20k-package dpkg status file, with
+// the SIMD scan against reading it line by line through a stream
+
+constexpr int PACKAGES = 20000;
+constexpr int ITERATIONS = 50;
+
+// Stanzas shaped like real ones: a handful of fields, a wrapped
+// description, and every few packages one that is not installed
+static std::string statusFile() {
+    std::string status;
+    for (int i = 0; i < PACKAGES; i++) {
+        std::string name = "package-" + std::to_string(i);
+        status += "Package: " + name + "\n";
+        status += i % 10 == 9 ? "Status: deinstall ok config-files\n" : "Status: install ok installed\n";
+        status += "Priority: optional\nSection: libs\nInstalled-Size: " + std::to_string(100 + i % 900) + "\n"
+                  "Maintainer: Example Maintainers <maint@example.org>\nArchitecture: amd64\n"
+                  "Version: 1." + std::to_string(i % 50) + "-" + std::to_string(i % 7) + "\n"
+                  "Depends: libc6 (>= 2.34), libstdc++6 (>= 12)\n"
+                  "Description: synthetic package " + name + "\n"
+                  " A longer description, wrapped the way dpkg keeps it, so that lines\n"
+                  " starting with S are not only the Status ones: Section, Suggests.\n\n";
+    }
+    return status;
+}
+
+static int streamCount(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    int count = 0;
+    while (std::getline(in, line)) {
+        if (line.starts_with("Status: ") && line.ends_with(" ok installed")) count++;
+    }
+    return count;
+}
+
+template <typename Count>
+static void report(const char* name, const std::string& path, size_t bytes, Count count) {
+    int total = 0;  // Keeps the loop from being optimized away
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) total += count(path);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    double ms = elapsed.count() / ITERATIONS;
+    std::printf("%-16s %6d pkgs %8.3f ms %6.2f GB/s\n", name, total / ITERATIONS, ms, bytes / ms / 1e6);
+}
+
+int main() {
+    char path[] = "/tmp/kfetch-bench-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return 1;
+    close(fd);
+    std::string status = statusFile();
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << status;
+
+    std::printf("status file: %d packages, %.1f MB\n", PACKAGES, status.size() / 1e6);
+    report("dpkg scan", path, status.size(), countDpkgPackages);
+    report("getline", path, status.size(), streamCount);
+
+    unlink(path);
+    return 0;
+}
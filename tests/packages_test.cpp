@@ -0,0 +1,163 @@
+#include "packages/packages.h"
+#include "check.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace kfetch;
+namespace fs = std::filesystem;
+
+// tests/fixtures/root is a small sysroot with one database per package
+// manager; the rpmdb and its WAL come from tests/fixtures/rpmdb.sql
+const std::string ROOT = "tests/fixtures/root";
+const std::string RPM_DIR = ROOT + "/usr/lib/sysimage/rpm";
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+}
+
+static void testTextDatabases() {
+    // install, hold; not config-files, half-installed or a description line
+    CHECK_EQ(countDpkgPackages(ROOT + "/var/lib/dpkg/status"), 4);
+    CHECK_EQ(countApkPackages(ROOT + "/lib/apk/db/installed"), 3);
+    // Not _XBPS_ALTERNATIVES_, nor the dicts nested in a package
+    CHECK_EQ(countXbpsPackages(ROOT + "/var/db/xbps"), 3);
+    // Not ALPM_DB_VERSION
+    CHECK_EQ(countPacmanPackages(ROOT + "/var/lib/pacman/local"), 3);
+    CHECK_EQ(countPortagePackages(ROOT + "/var/db/pkg"), 3);
+
+    CHECK_EQ(countDpkgPackages(ROOT + "/missing"), -1);
+    CHECK_EQ(countApkPackages(ROOT + "/missing"), -1);
+    CHECK_EQ(countXbpsPackages(ROOT + "/missing"), -1);
+    CHECK_EQ(countPacmanPackages(ROOT + "/missing"), -1);
+}
+
+static void testEdgeCases(const std::string& dir) {
+    // A record on the first line has no newline in front of it
+    writeFile(dir + "/installed", "P:musl\nV:1.2.4\n\nP:busybox\n");
+    CHECK_EQ(countApkPackages(dir + "/installed"), 2);
+
+    // An empty database is there, with nothing installed
+    writeFile(dir + "/installed", "");
+    CHECK_EQ(countApkPackages(dir + "/installed"), 0);
+    writeFile(dir + "/status", "");
+    CHECK_EQ(countDpkgPackages(dir + "/status"), 0);
+
+    // Long enough for the vector scan, with a match straddling each block
+    std::string status;
+    for (int i = 0; i < 100; i++) {
+        status += "Package: p" + std::string(i % 17, 'x') + "\nStatus: install ok installed\n\n";
+    }
+    writeFile(dir + "/status", status);
+    CHECK_EQ(countDpkgPackages(dir + "/status"), 100);
+
+    // The same scan finds apk's P: records, with T:P: decoys in between
+    std::string installed;
+    for (int i = 0; i < 100; i++) {
+        installed += "C:Q1" + std::string(i % 19, 'c') + "=\nP:p" + std::to_string(i) + "\nT:P:decoy\n\n";
+    }
+    writeFile(dir + "/installed", installed);
+    CHECK_EQ(countApkPackages(dir + "/installed"), 100);
+
+    // xbps reads the newest pkgdb format there is
+    fs::create_directories(dir + "/xbps");
+    std::string plist_head = "<plist version=\"1.0\">\n<dict>\n";
+    writeFile(dir + "/xbps/pkgdb-0.21.plist", plist_head + "<key>old</key>\n<dict>\n</dict>\n</dict>\n</plist>\n");
+    writeFile(dir + "/xbps/pkgdb-0.38.plist", plist_head + "<key>a</key>\n<dict>\n</dict>\n"
+                                              "<key>b</key>\n<dict>\n</dict>\n</dict>\n</plist>\n");
+    CHECK_EQ(countXbpsPackages(dir + "/xbps"), 2);
+}
+
+// Offset of every WAL frame that ends a transaction
+static std::vector<size_t> commitFrames(const std::string& wal) {
+    auto be32 = [&](size_t at) {
+        const auto* p = reinterpret_cast<const unsigned char*>(wal.data() + at);
+        return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | p[3];
+    };
+    size_t frame_size = 24 + be32(8);
+    std::vector<size_t> commits;
+    for (size_t off = 32; off + frame_size <= wal.size(); off += frame_size) {
+        if (be32(off + 4) != 0) commits.push_back(off);
+    }
+    return commits;
+}
+
+static void testSqlite(const std::string& dir) {
+    // 200 rows in the main file, 20 and then 100 more in two WAL transactions
+    CHECK_EQ(countRpmPackages(RPM_DIR), 320);
+    // 64 KiB pages (stored as 1), a schema entry spilling to overflow pages
+    // ahead of Packages, and rows larger than a page; see rpmdb64k.sql
+    CHECK_EQ(countRpmPackages("tests/fixtures/rpm64k"), 702);
+
+    std::string db = readFile(RPM_DIR + "/rpmdb.sqlite");
+    std::string wal = readFile(RPM_DIR + "/rpmdb.sqlite-wal");
+    std::vector<size_t> commits = commitFrames(wal);
+    CHECK_EQ(commits.size(), size_t{2});
+    if (commits.size() != 2) return;
+    size_t last = commits[1];
+    size_t frame_size = wal.size() - last;
+
+    writeFile(dir + "/rpmdb.sqlite", db);
+    auto countWith = [&](const std::string& contents) {
+        writeFile(dir + "/rpmdb.sqlite-wal", contents);
+        return countRpmPackages(dir);
+    };
+
+    CHECK_EQ(countWith(wal), 320);
+    // A torn final frame drops its transaction, not the one before
+    CHECK_EQ(countWith(wal.substr(0, last + frame_size / 2)), 220);
+    // Frames written without their commit frame are not visible
+    CHECK_EQ(countWith(wal.substr(0, last)), 220);
+    // Nor is anything after a frame whose checksum does not match
+    std::string corrupt = wal;
+    corrupt[commits[0] + frame_size + 100] ^= 0x55;
+    CHECK_EQ(countWith(corrupt), 220);
+    // A WAL whose header does not check out is ignored entirely
+    std::string bad_header = wal;
+    bad_header[20] ^= 1;
+    CHECK_EQ(countWith(bad_header), 200);
+    CHECK_EQ(countWith(""), 200);
+
+    fs::remove(dir + "/rpmdb.sqlite-wal");
+    CHECK_EQ(countRpmPackages(dir), 200);
+
+    // Not an SQLite file, or a table that is not there
+    writeFile(dir + "/rpmdb.sqlite", "SQLite format 2\n" + std::string(200, '\0'));
+    CHECK_EQ(countRpmPackages(dir), -1);
+    writeFile(dir + "/local.sqlite", db);
+    CHECK_EQ(countPkgPackages(dir), -1);
+    CHECK_EQ(countRpmPackages(ROOT + "/missing"), -1);
+}
+
+static void testSysroot() {
+    auto found = countPackages(ROOT);
+    std::sort(found.begin(), found.end());
+    std::vector<std::pair<std::string, int>> expected = {
+        {"apk", 3}, {"dpkg", 4}, {"pacman", 3}, {"portage", 3}, {"rpm", 320}, {"xbps", 3},
+    };
+    CHECK(found == expected);
+}
+
+int main() {
+    char dir_template[] = "/tmp/kfetch-test-XXXXXX";
+    const char* dir = mkdtemp(dir_template);
+    if (!dir) return 1;
+
+    testTextDatabases();
+    testEdgeCases(dir);
+    testSqlite(dir);
+    testSysroot();
+
+    fs::remove_all(dir);
+    return checkResult("packages");
+}
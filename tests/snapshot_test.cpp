@@ -0,0 +1,63 @@
+#include "snapshot/snapshot.h"
+#include "check.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace kfetch;
+using namespace std::chrono_literals;
+
+constexpr FieldMask FIELDS = FIELD_HOSTNAME | FIELD_UPTIME | FIELD_MEMORY;
+
+static void testBeforeStart() {
+    // Nothing is collected until the updater runs, and reading does not
+    // collect either
+    SnapshotStore store(FIELDS);
+    std::shared_ptr<const Info> empty = store.current();
+    CHECK(empty != nullptr);
+    CHECK_EQ(empty->fields, FieldMask{0});
+}
+
+static void testReadersDuringRefresh() {
+    SnapshotStore store(FIELDS);
+    store.setRefreshInterval(FIELD_UPTIME, 1ms);
+    store.setRefreshInterval(FIELD_MEMORY, 1ms);
+    store.start();
+
+    // Readers hammer current() while the updater publishes every
+    // millisecond; each snapshot they get must be whole and must never
+    // go back to having fewer fields
+    std::atomic<bool> done{false};
+    std::atomic<unsigned> bad{0}, changes{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&] {
+            std::shared_ptr<const Info> last = store.current();
+            while (!done) {
+                std::shared_ptr<const Info> now = store.current();
+                if (!now || (now->fields & last->fields) != last->fields) bad++;
+                if (now->fields == FIELDS && now->hostname.empty()) bad++;
+                if (now != last) changes++;
+                last = std::move(now);
+            }
+        });
+    }
+    std::this_thread::sleep_for(200ms);
+    done = true;
+    for (auto& reader : readers) reader.join();
+    store.stop();
+
+    CHECK_EQ(bad.load(), 0u);
+    CHECK(changes.load() > 4);
+    std::shared_ptr<const Info> latest = store.current();
+    CHECK_EQ(latest->fields, FIELDS);
+    CHECK(latest->memory_total_bytes > 0);
+}
+
+int main() {
+    testBeforeStart();
+    testReadersDuringRefresh();
+    return checkResult("snapshot");
+}
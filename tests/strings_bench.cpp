@@ -0,0 +1,70 @@
+#include "utils.h"
+#include "gpu/gpu.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace kfetch;
+
+// ns and heap allocations per call for the copying string helpers and the
+// view-based ones that replaced them
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+constexpr int ITERATIONS = 100000;
+
+template <typename Run>
+static void report(const char* name, Run run) {
+    size_t total = 0;  // Keeps the loop from being optimized away
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) total += run();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (total == 0) std::puts("");
+    std::printf("%-24s %7.1f ns %5.1f allocs\n", name, elapsed.count() / ITERATIONS,
+                static_cast<double>(allocations - before) / ITERATIONS);
+}
+
+static std::string copyingTrim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\n\r");
+    if (first == std::string::npos) return "";
+    size_t last = str.find_last_not_of(" \t\n\r");
+    return str.substr(first, (last - first + 1));
+}
+
+static std::vector<std::string> copyingSplit(const std::string& str, char delimiter) {
+    std::vector<std::string> tokens;
+    std::stringstream ss(str);
+    std::string token;
+    while (std::getline(ss, token, delimiter)) tokens.push_back(copyingTrim(token));
+    return tokens;
+}
+
+int main() {
+    const std::string gpu = "NVIDIA Corporation GA102 [GeForce RTX 3080] (rev a1)";
+    const std::string field = "   PRETTY_NAME = \"Arch Linux\"   ";
+    const std::string fields = "user, nice, system, idle, iowait, irq";
+
+    report("gpu formatGpuName", [&] { return formatGpuName(gpu).size(); });
+    report("trim (copy)", [&] { return copyingTrim(field).size(); });
+    report("trimView", [&] { return trimView(field).size(); });
+    report("split 6 fields (copy)", [&] { return copyingSplit(fields, ',').size(); });
+    report("split 6 fields (view)", [&] {
+        size_t size = 0;
+        for (std::string_view part : split(fields, ',')) size += part.size();
+        return size;
+    });
+    return 0;
+}
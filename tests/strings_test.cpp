@@ -0,0 +1,172 @@
+#include "utils.h"
+#include "gpu/gpu.h"
+#include "check.h"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kfetch;
+
+// The copying helpers the view-based ones replaced, kept as references
+
+static std::string oldTrim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\n\r");
+    if (first == std::string::npos) return "";
+    size_t last = str.find_last_not_of(" \t\n\r");
+    return str.substr(first, (last - first + 1));
+}
+
+static std::string oldToLower(const std::string& str) {
+    std::string result = str;
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return std::tolower(c); });
+    return result;
+}
+
+static std::vector<std::string> oldSplit(const std::string& str, char delimiter) {
+    std::vector<std::string> tokens;
+    std::stringstream ss(str);
+    std::string token;
+    while (std::getline(ss, token, delimiter)) tokens.push_back(oldTrim(token));
+    return tokens;
+}
+
+static std::string oldReplace(const std::string& str, const std::string& from, const std::string& to) {
+    std::string result = str;
+    size_t pos = 0;
+    while ((pos = result.find(from, pos)) != std::string::npos) {
+        result.replace(pos, from.length(), to);
+        pos += to.length();
+    }
+    return result;
+}
+
+// GPUInfo::getFormatted before it moved to the in-place helpers, with its
+// replacements in the order formatGpuName fixes
+static std::string oldFormatGpuName(const std::string& name) {
+    std::string simplified = name;
+    static const std::pair<std::string, std::string> replacements[] = {
+        {"Advanced Micro Devices", "AMD"}, {"Intel Corporation", "Intel"},
+        {"NVIDIA Corporation", "NVIDIA"}, {"Corporation", ""}, {"Inc.", ""},
+    };
+    for (const auto& [from, to] : replacements) simplified = oldReplace(simplified, from, to);
+    for (auto prefix : {"vendor ", "device "}) {
+        if (simplified.starts_with(prefix)) simplified.erase(0, std::char_traits<char>::length(prefix));
+    }
+    std::erase_if(simplified, [](char c) { return c == '\'' || c == '\"' || c == ',' || c == '[' || c == ']'; });
+    std::string result;
+    bool last_space = false;
+    for (char c : simplified) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!last_space) result += ' ';
+            last_space = true;
+        } else {
+            result += c;
+            last_space = false;
+        }
+    }
+    return oldTrim(result);
+}
+
+static const std::string samples[] = {
+    "", " ", "a", " a ", "\t\r\n", "  two  words  ", "a,b,c", " a , b ,c ", ",", ",,", "a,,b", ",a",
+    "key = value", "NAME=\"Arch Linux\"", "mixed CASE Text 123", "Ünïcode bytes ß",
+};
+
+static void testTrim() {
+    for (const std::string& sample : samples) {
+        CHECK_EQ(std::string(trimView(sample)), oldTrim(sample));
+        CHECK_EQ(trim(sample), oldTrim(sample));
+    }
+    static_assert(trimView("  x  ") == "x");
+}
+
+static void testCase() {
+    for (const std::string& sample : samples) {
+        std::string lower = sample;
+        toLowerInPlace(lower);
+        CHECK_EQ(lower, oldToLower(sample));
+        CHECK(equalsIgnoreCase(sample, oldToLower(sample)));
+    }
+    CHECK(!equalsIgnoreCase("abc", "abd"));
+    CHECK(!equalsIgnoreCase("abc", "ab"));
+}
+
+static void testSplitJoin() {
+    for (const std::string& sample : samples) {
+        std::vector<std::string> fields;
+        for (std::string_view field : split(sample, ',')) fields.emplace_back(field);
+        // getline drops a trailing empty field, which the view keeps
+        std::vector<std::string> expected = oldSplit(sample, ',');
+        if (sample.ends_with(',')) expected.emplace_back();
+        CHECK(fields == expected);
+
+        std::string joined = expected.empty() ? "" : expected[0];
+        for (size_t i = 1; i < expected.size(); i++) joined += ", " + expected[i];
+        CHECK_EQ(join(fields, ", "), joined);
+    }
+    CHECK_EQ(join(std::vector<std::string_view>{}, ", "), "");
+}
+
+static void testReplace() {
+    static const struct {
+        std::string text, from, to;
+    } cases[] = {
+        {"aaa", "a", "aa"}, {"abcabc", "bc", ""}, {"abc", "", "x"}, {"Intel Corporation", "Corporation", ""},
+        {"none here", "zz", "y"}, {"xxxx", "xx", "x"},
+    };
+    for (const auto& [text, from, to] : cases) {
+        std::string replaced = text;
+        replaceAll(replaced, from, to);
+        CHECK_EQ(replaced, from.empty() ? text : oldReplace(text, from, to));
+    }
+}
+
+static void testCollapseSpaces() {
+    static const struct {
+        const char* text;
+        const char* expected;
+    } cases[] = {
+        {"", ""}, {"   ", ""}, {"a", "a"}, {"  a  b  ", "a b"}, {"a\t\tb\nc", "a b c"}, {"a \r\n b", "a b"},
+    };
+    for (const auto& [text, expected] : cases) {
+        std::string collapsed = text;
+        collapseSpaces(collapsed);
+        CHECK_EQ(collapsed, expected);
+    }
+}
+
+static void testGpuNames() {
+    static const struct {
+        const char* name;
+        const char* expected;
+    } cases[] = {
+        {"NVIDIA Corporation GA102 [GeForce RTX 3080] (rev a1)", "NVIDIA GA102 GeForce RTX 3080 (rev a1)"},
+        {"Advanced Micro Devices, Inc. [AMD/ATI] Navi 21 [Radeon RX 6800/6800 XT / 6900 XT] (rev c1)",
+         "AMD AMD/ATI Navi 21 Radeon RX 6800/6800 XT / 6900 XT (rev c1)"},
+        {"Intel Corporation Alder Lake-P GT2 [Iris Xe Graphics] (rev 0c)", "Intel Alder Lake-P GT2 Iris Xe Graphics (rev 0c)"},
+        {"Matrox Electronics Systems Ltd. MGA G200e [Pilot] ServerEngines (SEP1) (rev 05)",
+         "Matrox Electronics Systems Ltd. MGA G200e Pilot ServerEngines (SEP1) (rev 05)"},
+        // FreeBSD's pciconf vendor and device values, closing quotes included
+        {"NVIDIA Corporation' 'GA102 [GeForce RTX 3080]'", "NVIDIA GA102 GeForce RTX 3080"},
+        {"vendor Red Hat, Inc.", "Red Hat"},
+        {"  NVIDIA   GeForce\tRTX 4090  ", "NVIDIA GeForce RTX 4090"},
+        {"", ""},
+    };
+    for (const auto& [name, expected] : cases) {
+        CHECK_EQ(formatGpuName(name), expected);
+        CHECK_EQ(formatGpuName(name), oldFormatGpuName(name));
+    }
+}
+
+int main() {
+    testTrim();
+    testCase();
+    testSplitJoin();
+    testReplace();
+    testCollapseSpaces();
+    testGpuNames();
+    return checkResult("strings");
+}
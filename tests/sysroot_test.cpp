@@ -0,0 +1,84 @@
+#include "libkfetch.h"
+#include "utils.h"
+#include "check.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+using namespace kfetch;
+namespace fs = std::filesystem;
+
+// A sysroot laid out as installed systems often are, with absolute
+// symlinks that point at the host unless resolved inside the root
+
+static void writeFile(const std::string& path, std::string_view content) {
+    fs::create_directories(fs::path(path).parent_path());
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+}
+
+static void makeRoot(const std::string& root) {
+    writeFile(root + "/usr/lib/os-release", "ID=kfetchtest\nPRETTY_NAME=\"kfetch Test OS\"\n");
+    fs::create_directories(root + "/etc");
+    fs::create_symlink("/usr/lib/os-release", root + "/etc/os-release");
+
+    // The sysroot's shell is the one of the user running kfetch
+    std::string uid = std::to_string(getuid()), other = std::to_string(getuid() + 1);
+    writeFile(root + "/usr/share/base/passwd", "other:x:" + other + ":" + other + "::/:/bin/false\n"
+                                               "tester:x:" + uid + ":" + uid + "::/home/tester:/bin/sh\n");
+    fs::create_symlink("/usr/share/base/passwd", root + "/etc/passwd");
+    writeFile(root + "/usr/bin/dash", "");
+    fs::create_symlink("usr/bin", root + "/bin");
+    fs::create_symlink("/usr/bin/dash", root + "/usr/bin/sh");
+
+    // /var/lib/dpkg moved to /srv, linked back absolutely
+    writeFile(root + "/srv/dpkg/status", "Package: a\nStatus: install ok installed\n\n"
+                                         "Package: b\nStatus: install ok installed\n");
+    fs::create_directories(root + "/var/lib");
+    fs::create_symlink("/srv/dpkg", root + "/var/lib/dpkg");
+}
+
+static void testResolveUnder(const std::string& root) {
+    CHECK_EQ(resolveUnder("", "/etc/os-release"), "/etc/os-release");
+    CHECK_EQ(resolveUnder(root, "/etc/os-release"), root + "/usr/lib/os-release");
+    CHECK_EQ(resolveUnder(root, "/bin/sh"), root + "/usr/bin/dash");
+    CHECK_EQ(resolveUnder(root, "/var/lib/dpkg/status"), root + "/srv/dpkg/status");
+    // ".." stops at the root, and a missing path is returned as it is
+    CHECK_EQ(resolveUnder(root, "/../../etc/../usr/lib/os-release"), root + "/usr/lib/os-release");
+    CHECK_EQ(resolveUnder(root, "/no/such/file"), root + "/no/such/file");
+
+    // A link loop ends instead of spinning
+    fs::create_symlink("/loop", root + "/loop");
+    CHECK(resolveUnder(root, "/loop").starts_with(root));
+}
+
+static void testCollect(const std::string& root) {
+    Info info = collect(FIELD_OS | FIELD_SHELL | FIELD_PACKAGES, {root});
+    CHECK_EQ(std::string_view(info.distro_name), "kfetchtest");
+    CHECK_EQ(std::string_view(info.distro_pretty_name), "kfetch Test OS");
+    CHECK_EQ(std::string_view(info.shell), "dash");
+    CHECK_EQ(std::string_view(info.packages), "2 (dpkg)");
+
+    // The batched reads of prefetch() take the same paths
+    std::string roots[] = {root};
+    Info prefetched[1];
+    prefetch(prefetched, roots, FIELD_OS | FIELD_SHELL);
+    CHECK_EQ(std::string_view(prefetched[0].distro_name), "kfetchtest");
+    CHECK_EQ(std::string_view(prefetched[0].shell), "dash");
+}
+
+int main() {
+    char dir_template[] = "/tmp/kfetch-test-XXXXXX";
+    const char* dir = mkdtemp(dir_template);
+    if (!dir) return 1;
+    std::string root = dir;
+
+    makeRoot(root);
+    testResolveUnder(root);
+    testCollect(root);
+
+    fs::remove_all(root);
+    return checkResult("sysroot");
+}
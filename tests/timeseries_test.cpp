@@ -0,0 +1,127 @@
+#include "timeseries/timeseries.h"
+#include "check.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace kfetch;
+namespace fs = std::filesystem;
+
+static void testVarint() {
+    constexpr int64_t MIN = std::numeric_limits<int64_t>::min(), MAX = std::numeric_limits<int64_t>::max();
+    const int64_t values[] = {0, 1, -1, 63, -64, 64, -65, 127, 128, 300, -300, 1 << 20, -(1 << 20),
+                              int64_t{1} << 40, -(int64_t{1} << 40), MAX, MIN, MAX - 1, MIN + 1};
+    unsigned char buf[16];
+    for (int64_t value : values) {
+        size_t n = putVarint(buf, value);
+        CHECK(n >= 1 && n <= 10);
+        const unsigned char* p = buf;
+        int64_t decoded = 0;
+        CHECK(getVarint(p, buf + n, decoded));
+        CHECK_EQ(decoded, value);
+        CHECK(p == buf + n);
+
+        // A varint cut short is not a value
+        p = buf;
+        if (n > 1) CHECK(!getVarint(p, buf + n - 1, decoded));
+    }
+
+    // Zigzag keeps small magnitudes short, whatever their sign
+    CHECK_EQ(putVarint(buf, -1), size_t{1});
+    CHECK_EQ(putVarint(buf, -64), size_t{1});
+    CHECK_EQ(putVarint(buf, 64), size_t{2});
+    CHECK_EQ(putVarint(buf, MIN), size_t{10});
+}
+
+// Every field a function of i, with deltas of all sizes and signs
+static Sample sampleAt(int64_t i) {
+    Sample sample;
+    sample.time = 1700000000 + i;
+    sample.uptime = 1000 + i;
+    sample.mem_used_kb = (i * 7919) % 1000003 * (i % 2 ? 1 : 1000);
+    sample.mem_total_kb = 16 << 20;
+    sample.load1 = i % 400;
+    sample.load5 = (i * 13) % 400;
+    sample.load15 = 100;
+    sample.gpu_mem_kb = i % 3 == 0 ? -1 : i * 1024;
+    return sample;
+}
+
+// time and mem_used_kb of each replayed sample
+static std::vector<std::pair<int64_t, int64_t>> replayed(const std::string& path) {
+    SampleRing ring;
+    std::vector<std::pair<int64_t, int64_t>> rows;
+    if (!ring.open(path, false)) return rows;
+    std::ostringstream out;
+    ring.replay(out);
+
+    std::istringstream in(out.str());
+    std::string line;
+    std::getline(in, line);  // Header
+    while (std::getline(in, line)) {
+        int64_t time = std::stoll(line);
+        size_t field = line.find(',', line.find(',') + 1);
+        rows.emplace_back(time, std::stoll(line.substr(field + 1)));
+    }
+    return rows;
+}
+
+static void testWrapAround(const std::string& dir) {
+    // Enough samples for the ring to wrap several times, written in two
+    // sessions so the second resumes the newest block
+    std::string path = dir + "/ring";
+    constexpr int64_t SAMPLES = 200000;
+    for (int64_t session = 0; session < 2; session++) {
+        SampleRing ring;
+        CHECK(ring.open(path, true));
+        for (int64_t i = session * SAMPLES / 2; i < (session + 1) * SAMPLES / 2; i++) ring.append(sampleAt(i));
+    }
+
+    // The oldest blocks are gone; what is left is the newest samples,
+    // contiguous and decoded exactly
+    auto rows = replayed(path);
+    CHECK(!rows.empty() && rows.size() < SAMPLES);
+    CHECK(rows.size() > SampleRing::BLOCK_COUNT * 10);
+    if (rows.empty()) return;
+    int64_t first = rows.front().first - sampleAt(0).time;
+    CHECK_EQ(rows.back().first, sampleAt(SAMPLES - 1).time);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < rows.size(); i++) {
+        Sample expected = sampleAt(first + static_cast<int64_t>(i));
+        if (rows[i].first != expected.time || rows[i].second != expected.mem_used_kb) mismatches++;
+    }
+    CHECK_EQ(mismatches, size_t{0});
+}
+
+static void testSingleRecorder(const std::string& dir) {
+    // A second writer is turned away while the first holds the ring;
+    // readers are not
+    std::string path = dir + "/locked";
+    SampleRing first;
+    CHECK(first.open(path, true));
+    first.append(sampleAt(0));
+
+    SampleRing second;
+    errno = 0;
+    CHECK(!second.open(path, true));
+    CHECK_EQ(errno, EWOULDBLOCK);
+    CHECK_EQ(replayed(path).size(), size_t{1});
+}
+
+int main() {
+    char dir_template[] = "/tmp/kfetch-test-XXXXXX";
+    const char* dir = mkdtemp(dir_template);
+    if (!dir) return 1;
+
+    testVarint();
+    testWrapAround(dir);
+    testSingleRecorder(dir);
+
+    fs::remove_all(dir);
+    return checkResult("timeseries");
+}
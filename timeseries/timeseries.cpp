@@ -0,0 +1,313 @@
+#include "timeseries.h"
+#include "utils.h"
+#include "memory/memory.h"
+#include "procfs/procfs.h"
+#include "numfmt.h"
+#include <charconv>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+    #include <sys/sysinfo.h>
+#endif
+
+namespace kfetch {
+
+size_t putVarint(unsigned char* out, int64_t value) {
+    uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    size_t n = 0;
+    while (zigzag >= 0x80) {
+        out[n++] = static_cast<unsigned char>(zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    out[n++] = static_cast<unsigned char>(zigzag);
+    return n;
+}
+
+bool getVarint(const unsigned char*& p, const unsigned char* end, int64_t& value) {
+    uint64_t zigzag = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        unsigned char byte = *p++;
+        zigzag |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace {
+
+struct RingHeader {
+    char magic[4];        // "KFTS"
+    uint32_t version;
+    uint32_t block_size;
+    uint32_t block_count;
+    uint32_t fields;
+    uint32_t reserved;
+    uint64_t next_seq;    // Sequence number the next block will get
+};
+
+struct BlockHeader {
+    uint64_t seq;         // 0 = never written
+    uint32_t used;        // Committed payload bytes
+    uint32_t count;       // Committed samples
+};
+
+constexpr uint32_t RING_VERSION = 1;
+constexpr size_t PAYLOAD_SIZE = SampleRing::BLOCK_SIZE - sizeof(BlockHeader);
+constexpr size_t MAX_ENCODED = Sample::FIELDS * 10;
+
+// Encode sample, as deltas against base when one is given
+size_t encode(unsigned char* out, const Sample& sample, const Sample* base) {
+    size_t n = 0;
+    for (size_t i = 0; i < Sample::FIELDS; i++) {
+        int64_t value = sample.begin()[i];
+        n += putVarint(out + n, base ? value - base->begin()[i] : value);
+    }
+    return n;
+}
+
+// Decode every committed sample of a block, calling fn(sample) for each
+template<typename Fn>
+void decodeBlock(const unsigned char* block, Fn fn) {
+    const auto* hdr = reinterpret_cast<const BlockHeader*>(block);
+    // std::atomic_ref<const T> is not valid before C++26, and the block may
+    // sit in a read-only mapping, so load through the builtin
+    uint32_t used = __atomic_load_n(&hdr->used, __ATOMIC_ACQUIRE);
+    uint32_t count = hdr->count;
+
+    const unsigned char* p = block + sizeof(BlockHeader);
+    const unsigned char* end = p + std::min<size_t>(used, PAYLOAD_SIZE);
+    Sample current;
+    for (uint32_t n = 0; n < count; n++) {
+        Sample next;
+        for (size_t i = 0; i < Sample::FIELDS; i++) {
+            int64_t value;
+            if (!getVarint(p, end, value)) return;
+            next.begin()[i] = n == 0 ? value : current.begin()[i] + value;
+        }
+        current = next;
+        fn(current);
+    }
+}
+
+volatile std::sig_atomic_t stop_recording = 0;
+
+void onStopSignal(int) {
+    stop_recording = 1;
+}
+
+} // namespace
+
+SampleRing::~SampleRing() {
+    if (map) munmap(map, map_size);
+    if (fd >= 0) close(fd);
+}
+
+unsigned char* SampleRing::blockAt(uint64_t index) const {
+    // Block 0 of the file holds the ring header
+    return map + static_cast<size_t>(BLOCK_SIZE) * (1 + index % BLOCK_COUNT);
+}
+
+bool SampleRing::open(const std::string& path, bool writable) {
+    fd = ::open(path.c_str(), writable ? O_RDWR | O_CREAT | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    // Two recorders would write the same slots; the lock is taken before a
+    // fresh ring is initialized, so they cannot both do that either
+    if (writable && flock(fd, LOCK_EX | LOCK_NB) != 0) return false;
+
+    map_size = static_cast<size_t>(BLOCK_SIZE) * (BLOCK_COUNT + 1);
+    struct stat st;
+    if (fstat(fd, &st) != 0) return false;
+
+    bool fresh = st.st_size == 0;
+    if (fresh) {
+        if (!writable || ftruncate(fd, map_size) != 0) return false;
+    } else if (static_cast<size_t>(st.st_size) != map_size) {
+        return false;
+    }
+
+    void* addr = mmap(nullptr, map_size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                      MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) return false;
+    map = static_cast<unsigned char*>(addr);
+
+    auto* hdr = reinterpret_cast<RingHeader*>(map);
+    if (fresh) {
+        std::copy_n("KFTS", 4, hdr->magic);
+        hdr->version = RING_VERSION;
+        hdr->block_size = BLOCK_SIZE;
+        hdr->block_count = BLOCK_COUNT;
+        hdr->fields = Sample::FIELDS;
+        hdr->next_seq = 1;
+    }
+    if (!std::equal(hdr->magic, hdr->magic + 4, "KFTS") || hdr->version != RING_VERSION ||
+        hdr->block_size != BLOCK_SIZE || hdr->block_count != BLOCK_COUNT ||
+        hdr->fields != Sample::FIELDS) {
+        return false;
+    }
+
+    // Resume appending to the newest block
+    if (writable && hdr->next_seq > 1) {
+        block = blockAt(hdr->next_seq - 1);
+        decodeBlock(block, [&](const Sample& sample) { last = sample; });
+        if (reinterpret_cast<BlockHeader*>(block)->count == 0) block = nullptr;
+    }
+    return true;
+}
+
+void SampleRing::startBlock() {
+    auto* hdr = reinterpret_cast<RingHeader*>(map);
+    uint64_t seq = hdr->next_seq++;
+
+    block = blockAt(seq);
+    auto* bhdr = reinterpret_cast<BlockHeader*>(block);
+    std::atomic_ref<uint32_t>(bhdr->used).store(0, std::memory_order_release);
+    bhdr->count = 0;
+    bhdr->seq = seq;
+}
+
+void SampleRing::append(const Sample& sample) {
+    unsigned char encoded[MAX_ENCODED];
+    size_t len = 0;
+
+    auto* bhdr = block ? reinterpret_cast<BlockHeader*>(block) : nullptr;
+    if (bhdr) len = encode(encoded, sample, &last);
+    if (!bhdr || bhdr->used + len > PAYLOAD_SIZE) {
+        startBlock();
+        bhdr = reinterpret_cast<BlockHeader*>(block);
+        len = encode(encoded, sample, nullptr);
+    }
+
+    // Payload first, then publish it by bumping used/count
+    std::copy_n(encoded, len, block + sizeof(BlockHeader) + bhdr->used);
+    bhdr->count++;
+    std::atomic_ref<uint32_t>(bhdr->used).store(bhdr->used + len, std::memory_order_release);
+    last = sample;
+}
+
+void SampleRing::replay(std::ostream& out) const {
+    std::vector<const unsigned char*> blocks;
+    for (uint32_t i = 0; i < BLOCK_COUNT; i++) {
+        const unsigned char* b = blockAt(i);
+        if (reinterpret_cast<const BlockHeader*>(b)->seq != 0) blocks.push_back(b);
+    }
+    std::sort(blocks.begin(), blocks.end(), [](const unsigned char* a, const unsigned char* b) {
+        return reinterpret_cast<const BlockHeader*>(a)->seq < reinterpret_cast<const BlockHeader*>(b)->seq;
+    });
+
+    auto load = [](int64_t value) {
+        std::string s;
+        appendDecimal(s, value, 2);
+        return s;
+    };
+
+    out << "time,uptime,mem_used_kb,mem_total_kb,load1,load5,load15,gpu_mem_kb\n";
+    int64_t prev_uptime = -1;
+    for (const unsigned char* b : blocks) {
+        decodeBlock(b, [&](const Sample& s) {
+            if (s.uptime < prev_uptime) out << "# boot\n";
+            prev_uptime = s.uptime;
+            out << s.time << ',' << s.uptime << ',' << s.mem_used_kb << ',' << s.mem_total_kb << ','
+                << load(s.load1) << ',' << load(s.load5) << ',' << load(s.load15) << ','
+                << s.gpu_mem_kb << '\n';
+        });
+    }
+}
+
+bool takeSample(Sample& sample) {
+#ifdef __linux__
+    struct sysinfo si;
+    if (sysinfo(&si) != 0) return false;
+
+    constexpr int64_t LOAD_SCALE = 1 << SI_LOAD_SHIFT;
+    sample.time = std::time(nullptr);
+    sample.uptime = si.uptime;
+    MemoryStats memory;
+    if (readMeminfo(memory)) {
+        sample.mem_total_kb = memory.total_kb;
+        sample.mem_used_kb = memory.total_kb - memory.available_kb;
+    }
+    sample.load1 = static_cast<int64_t>(si.loads[0]) * 100 / LOAD_SCALE;
+    sample.load5 = static_cast<int64_t>(si.loads[1]) * 100 / LOAD_SCALE;
+    sample.load15 = static_cast<int64_t>(si.loads[2]) * 100 / LOAD_SCALE;
+
+    // amdgpu exports VRAM usage; resolve which card once
+    static const std::string vram_path = [] {
+        char path[64];
+        for (int card = 0; card < 4; card++) {
+            snprintf(path, sizeof(path), "/sys/class/drm/card%d/device/mem_info_vram_used", card);
+            if (pathExists(path)) return std::string(path);
+        }
+        return std::string();
+    }();
+    sample.gpu_mem_kb = -1;
+    if (!vram_path.empty()) {
+        char buf[32];
+        std::string_view vram = readPseudoLine(vram_path.c_str(), buf);
+        int64_t bytes = 0;
+        if (std::from_chars(vram.data(), vram.data() + vram.size(), bytes).ec == std::errc()) {
+            sample.gpu_mem_kb = bytes / 1024;
+        }
+    }
+    return true;
+#else
+    (void)sample;
+    return false;
+#endif
+}
+
+int recordSamples(const std::string& path, unsigned interval) {
+    SampleRing ring;
+    if (!ring.open(path, true)) {
+        if (errno == EWOULDBLOCK) {
+            std::cerr << "kfetch: " << path << " is being recorded by another kfetch\n";
+        } else {
+            std::cerr << "kfetch: cannot open record file " << path << "\n";
+        }
+        return 1;
+    }
+
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (!stop_recording) {
+        Sample sample;
+        if (!takeSample(sample)) {
+            std::cerr << "kfetch: recording is not supported on this system\n";
+            return 1;
+        }
+        ring.append(sample);
+
+        next.tv_sec += interval;
+        while (!stop_recording &&
+               clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr) == EINTR) {}
+    }
+    return 0;
+}
+
+int replaySamples(const std::string& path, std::ostream& out) {
+    SampleRing ring;
+    if (!ring.open(path, false)) {
+        std::cerr << "kfetch: cannot read record file " << path << "\n";
+        return 1;
+    }
+    ring.replay(out);
+    return 0;
+}
+
+} // namespace kfetch
@@ -0,0 +1,78 @@
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace kfetch {
+
+// One sample of the volatile fields, all integers so they delta-encode well
+struct Sample {
+    int64_t time = 0;         // Unix seconds
+    int64_t uptime = 0;       // Seconds since boot
+    int64_t mem_used_kb = 0;
+    int64_t mem_total_kb = 0;
+    int64_t load1 = 0;        // Load averages x100
+    int64_t load5 = 0;
+    int64_t load15 = 0;
+    int64_t gpu_mem_kb = -1;  // -1 when no GPU exports VRAM usage
+
+    static constexpr size_t FIELDS = 8;
+    int64_t* begin() { return &time; }
+    const int64_t* begin() const { return &time; }
+};
+
+// Fixed-size mmapped ring of 4 KiB blocks. Each block starts with an absolute
+// sample followed by zigzag-varint deltas, so the oldest block can be
+// overwritten without losing the base the remaining blocks decode from.
+class SampleRing {
+private:
+    int fd = -1;
+    unsigned char* map = nullptr;
+    size_t map_size = 0;
+    unsigned char* block = nullptr;  // Block currently appended to
+    Sample last;                     // Last sample in that block
+
+    unsigned char* blockAt(uint64_t index) const;
+    void startBlock();
+
+public:
+    static constexpr uint32_t BLOCK_SIZE = 4096;
+    static constexpr uint32_t BLOCK_COUNT = 256;
+
+    SampleRing() = default;
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+    ~SampleRing();
+
+    // Map an existing ring, or create it when writable and missing. A
+    // writable ring is flock()ed for as long as it is open; while another
+    // writer holds it, open fails with errno EWOULDBLOCK.
+    bool open(const std::string& path, bool writable);
+
+    void append(const Sample& sample);
+
+    // Print every stored sample, oldest first, as CSV
+    void replay(std::ostream& out) const;
+};
+
+// Zigzag varints the deltas are stored as: putVarint writes at most 10
+// bytes and returns how many; getVarint advances p past one, or returns
+// false when it runs into end
+size_t putVarint(unsigned char* out, int64_t value);
+bool getVarint(const unsigned char*& p, const unsigned char* end, int64_t& value);
+
+// Read the current values; cheap enough to call every few seconds
+bool takeSample(Sample& sample);
+
+// Sample every interval seconds into path until SIGINT/SIGTERM
+int recordSamples(const std::string& path, unsigned interval);
+
+// Print the samples stored in path
+int replaySamples(const std::string& path, std::ostream& out);
+
+} // namespace kfetch
+
+#endif // TIMESERIES_H
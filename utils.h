@@ -4,91 +4,216 @@
 #include <string>
 #include <algorithm>
 #include <vector>
-#include <sstream>
+#include <ranges>
+#include <string_view>
 #include <fstream>
 #include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <atomic>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 namespace kfetch {
 
 // --- String helpers ---------------------------------------------------------
-inline std::string trim(const std::string& str) {
-    size_t first = str.find_first_not_of(" \t\n\r");
-    if (first == std::string::npos) return "";
-    size_t last = str.find_last_not_of(" \t\n\r");
-    return str.substr(first, (last - first + 1));
+// These work on views and edit in place; the std::string-returning trim is
+// only for callers that keep the result.
+
+constexpr std::string_view WHITESPACE = " \t\n\r";
+
+constexpr std::string_view trimView(std::string_view str) {
+    size_t first = str.find_first_not_of(WHITESPACE);
+    if (first == std::string_view::npos) return {};
+    size_t last = str.find_last_not_of(WHITESPACE);
+    return str.substr(first, last - first + 1);
 }
 
-inline std::string toLower(const std::string& str) {
-    std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(),
-                   [](unsigned char c){ return std::tolower(c); });
-    return result;
+inline std::string trim(std::string_view str) {
+    return std::string(trimView(str));
 }
 
-inline std::vector<std::string> split(const std::string& str, char delimiter) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    
-    while (std::getline(ss, token, delimiter)) {
-        tokens.push_back(trim(token));
-    }
-    
-    return tokens;
+constexpr char asciiLower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
 }
 
-inline std::string join(const std::vector<std::string>& vec, const std::string& delimiter) {
-    if (vec.empty()) return "";
-    
-    std::string result = vec[0];
-    for (size_t i = 1; i < vec.size(); ++i) {
-        result += delimiter + vec[i];
+// The in-place helpers take any std::basic_string, pmr ones included
+template <typename String>
+void toLowerInPlace(String& str) {
+    for (char& c : str) c = asciiLower(c);
+}
+
+constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (asciiLower(a[i]) != asciiLower(b[i])) return false;
     }
-    
-    return result;
+    return true;
 }
 
-inline bool startsWith(const std::string& str, const std::string& prefix) {
-    return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+// Lazy range of the trimmed fields of str between delimiters
+inline auto split(std::string_view str, char delimiter) {
+    return std::views::split(str, delimiter) | std::views::transform([](auto field) {
+        return trimView(std::string_view(field.begin(), field.end()));
+    });
 }
 
-inline bool endsWith(const std::string& str, const std::string& suffix) {
-    return str.size() >= suffix.size() && 
-           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+template <typename Range>
+std::string join(const Range& parts, std::string_view delimiter) {
+    size_t length = 0;
+    for (std::string_view part : parts) length += part.size() + delimiter.size();
+
+    std::string result;
+    result.reserve(length);
+    bool first = true;
+    for (std::string_view part : parts) {
+        if (!first) result += delimiter;
+        result += part;
+        first = false;
+    }
+    return result;
 }
 
-inline std::string replace(const std::string& str, const std::string& from, const std::string& to) {
-    std::string result = str;
+template <typename String>
+void replaceAll(String& str, std::string_view from, std::string_view to) {
+    if (from.empty()) return;
     size_t pos = 0;
-    while ((pos = result.find(from, pos)) != std::string::npos) {
-        result.replace(pos, from.length(), to);
-        pos += to.length();
+    while ((pos = str.find(from, pos)) != String::npos) {
+        str.replace(pos, from.size(), to);
+        pos += to.size();
     }
-    return result;
+}
+
+// Collapse whitespace runs to one space and trim, in place
+template <typename String>
+void collapseSpaces(String& str) {
+    size_t out = 0;
+    for (char c : str) {
+        bool space = WHITESPACE.find(c) != std::string_view::npos;
+        if (space && (out == 0 || str[out - 1] == ' ')) continue;
+        str[out++] = space ? ' ' : c;
+    }
+    if (out > 0 && str[out - 1] == ' ') out--;
+    str.resize(out);
 }
 
 // --- File/IO helpers --------------------------------------------------------
-inline std::string readFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) return "";
-    
-    std::string content((std::istreambuf_iterator<char>(file)),
-                        std::istreambuf_iterator<char>());
-    return trim(content);
+// Small /proc and /sys files are read through procfs/procfs.h
+
+// Replace path with content so readers never see a partial file
+inline bool writeFileAtomic(const std::string& path, const std::string& content) {
+    std::string tmp = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file(tmp, std::ios::trunc);
+        if (!file.is_open()) return false;
+        file << content;
+        if (!file.good()) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
 }
 
-inline std::string readFirstLine(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) return "";
-    
-    std::string line;
-    std::getline(file, line);
-    return trim(line);
+// Read-only private mapping of a whole file, read ahead as advised (e.g.
+// MADV_RANDOM for lookups); data() is null when the file could not be
+// mapped or is empty
+class MappedFile {
+private:
+    void* addr = nullptr;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const std::string& path, int advice = MADV_SEQUENTIAL) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                addr = map;
+                length = st.st_size;
+                madvise(addr, length, advice);
+            }
+        }
+        close(fd);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+        if (addr) munmap(addr, length);
+    }
+
+    const char* data() const { return static_cast<const char*>(addr); }
+    size_t size() const { return length; }
+};
+
+// $XDG_CACHE_HOME/kfetch or ~/.cache/kfetch, created on demand ("" if unusable)
+inline std::string cacheDirectory() {
+    std::string base;
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) base = xdg;
+    else if (const char* home = std::getenv("HOME"); home && *home) base = std::string(home) + "/.cache";
+    else return "";
+
+    mkdir(base.c_str(), 0755);
+    std::string dir = base + "/kfetch";
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return "";
+    return dir;
 }
 
-inline bool fileExists(const std::string& path) {
-    std::ifstream file(path);
-    return file.good();
+// Resolve path below root, following symlinks without escaping it:
+// absolute link targets are looked up under root again, as in a chroot.
+// Every lookup into a sysroot goes through here ("" = host, unchanged).
+inline std::string resolveUnder(const std::string& root, const std::string& path) {
+    if (root.empty()) return path;
+
+    std::vector<std::string> pending;  // Components still to walk, last first
+    auto push = [&](std::string_view rest) {
+        std::vector<std::string> parts;
+        size_t start = 0;
+        while (start <= rest.size()) {
+            size_t slash = std::min(rest.find('/', start), rest.size());
+            parts.emplace_back(rest.substr(start, slash - start));
+            start = slash + 1;
+        }
+        pending.insert(pending.end(), parts.rbegin(), parts.rend());
+    };
+
+    std::string resolved;
+    int links = 0;
+    push(path);
+    while (!pending.empty()) {
+        std::string part = std::move(pending.back());
+        pending.pop_back();
+        if (part.empty() || part == ".") continue;
+        if (part == "..") {
+            resolved.erase(std::min(resolved.size(), resolved.rfind('/')));
+            continue;
+        }
+
+        std::string next = resolved + "/" + part;
+        char target[PATH_MAX];
+        ssize_t len = readlink((root + next).c_str(), target, sizeof(target) - 1);
+        if (len < 0 || ++links > 40) {
+            resolved = std::move(next);
+            continue;
+        }
+        std::string_view link(target, len);
+        if (link.starts_with('/')) resolved.clear();
+        push(link);
+    }
+    return root + resolved;
 }
 
 // --- System helpers ---------------------------------------------------------
@@ -107,53 +232,39 @@ inline std::string executeCommand(const std::string& command) {
     return trim(result);
 }
 
-// --- Number formatting helpers ----------------------------------------------
-inline std::string formatBytes(uint64_t bytes) {
-    const char* units[] = {"B", "KB", "MB", "GB", "TB"};
-    const int numUnits = sizeof(units) / sizeof(units[0]);
-    
-    double size = static_cast<double>(bytes);
-    int unitIndex = 0;
-    
-    while (size >= 1024 && unitIndex < numUnits - 1) {
-        size /= 1024;
-        unitIndex++;
-    }
-    
-    std::ostringstream oss;
-    if (unitIndex == 0) {
-        oss << static_cast<uint64_t>(size) << " " << units[unitIndex];
-    } else {
-        oss.precision(1);
-        oss << std::fixed << size << " " << units[unitIndex];
-    }
-    
-    return oss.str();
+// Quote a string for use as a single /bin/sh word
+inline std::string shellQuote(const std::string& str) {
+    std::string body = str;
+    replaceAll(body, "'", "'\\''");
+    std::string quoted = "'";
+    quoted += body;
+    quoted += "'";
+    return quoted;
 }
 
-inline std::string formatUptime(uint64_t seconds) {
-    uint64_t days = seconds / 86400;
-    seconds %= 86400;
-    uint64_t hours = seconds / 3600;
-    seconds %= 3600;
-    uint64_t minutes = seconds / 60;
-    seconds %= 60;
-    
-    std::ostringstream oss;
-    if (days > 0) {
-        oss << days << "d ";
-    }
-    if (hours > 0 || days > 0) {
-        oss << hours << "h ";
-    }
-    if (minutes > 0 || hours > 0 || days > 0) {
-        oss << minutes << "m ";
-    }
-    oss << seconds << "s";
-    
-    return oss.str();
+// Run job(0) .. job(count - 1) on a pool of up to `workers` threads
+// (0 = one per hardware thread), the calling thread among them
+inline void parallelFor(size_t count, const std::function<void(size_t)>& job, unsigned workers = 0) {
+    if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    workers = static_cast<unsigned>(std::min<size_t>(workers, count));
+
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < count; i = next++) job(i);
+    };
+
+    // Short of threads (EAGAIN at a container's pids.max), the calling
+    // thread and those already started take the rest
+    std::vector<std::thread> pool;
+    try {
+        for (unsigned i = 1; i < workers; i++) pool.emplace_back(worker);
+    } catch (const std::system_error&) {}
+    if (workers > 0) worker();
+    for (auto& thread : pool) thread.join();
 }
 
+// --- Number formatting: see numfmt.h ----------------------------------------
+
 // --- Portable sysctlbyname --------------------------------------------------
 #if defined(__OpenBSD__)
 #include <sys/types.h>
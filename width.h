@@ -0,0 +1,153 @@
+#ifndef WIDTH_H
+#define WIDTH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace kfetch {
+
+// Terminal column widths. Zero-width and East Asian wide ranges are kept
+// as compact sorted tables; everything else printable is one column.
+
+struct CodepointRange {
+    char32_t first;
+    char32_t last;
+};
+
+// Combining marks, zero-width spaces/joiners and variation selectors
+inline constexpr CodepointRange ZERO_WIDTH[] = {
+    {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD}, {0x05BF, 0x05BF},
+    {0x05C1, 0x05C2}, {0x05C4, 0x05C5}, {0x05C7, 0x05C7}, {0x0610, 0x061A},
+    {0x064B, 0x065F}, {0x0670, 0x0670}, {0x06D6, 0x06DC}, {0x06DF, 0x06E4},
+    {0x06E7, 0x06E8}, {0x06EA, 0x06ED}, {0x0E31, 0x0E31}, {0x0E34, 0x0E3A},
+    {0x0E47, 0x0E4E}, {0x1AB0, 0x1AFF}, {0x1DC0, 0x1DFF}, {0x200B, 0x200F},
+    {0x202A, 0x202E}, {0x2060, 0x2064}, {0x20D0, 0x20FF}, {0xFE00, 0xFE0F},
+    {0xFE20, 0xFE2F}, {0xFEFF, 0xFEFF}, {0xE0100, 0xE01EF},
+};
+
+// East Asian Wide and Fullwidth, plus emoji presentation blocks
+inline constexpr CodepointRange DOUBLE_WIDTH[] = {
+    {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2329, 0x232A}, {0x23E9, 0x23EC},
+    {0x23F0, 0x23F0}, {0x23F3, 0x23F3}, {0x25FD, 0x25FE}, {0x2614, 0x2615},
+    {0x2648, 0x2653}, {0x267F, 0x267F}, {0x2693, 0x2693}, {0x26A1, 0x26A1},
+    {0x26AA, 0x26AB}, {0x26BD, 0x26BE}, {0x26C4, 0x26C5}, {0x26CE, 0x26CE},
+    {0x26D4, 0x26D4}, {0x26EA, 0x26EA}, {0x26F2, 0x26F3}, {0x26F5, 0x26F5},
+    {0x26FA, 0x26FA}, {0x26FD, 0x26FD}, {0x2705, 0x2705}, {0x270A, 0x270B},
+    {0x2728, 0x2728}, {0x274C, 0x274C}, {0x274E, 0x274E}, {0x2753, 0x2755},
+    {0x2757, 0x2757}, {0x2795, 0x2797}, {0x27B0, 0x27B0}, {0x27BF, 0x27BF},
+    {0x2B1B, 0x2B1C}, {0x2B50, 0x2B50}, {0x2B55, 0x2B55}, {0x2E80, 0x303E},
+    {0x3041, 0x33FF}, {0x3400, 0x4DBF}, {0x4E00, 0x9FFF}, {0xA000, 0xA4CF},
+    {0xA960, 0xA97F}, {0xAC00, 0xD7A3}, {0xF900, 0xFAFF}, {0xFE10, 0xFE19},
+    {0xFE30, 0xFE6F}, {0xFF00, 0xFF60}, {0xFFE0, 0xFFE6}, {0x16FE0, 0x18CFF},
+    {0x1B000, 0x1B2FF}, {0x1F004, 0x1F004}, {0x1F0CF, 0x1F0CF}, {0x1F18E, 0x1F18E},
+    {0x1F191, 0x1F19A}, {0x1F200, 0x1F251}, {0x1F300, 0x1F64F}, {0x1F680, 0x1F6FF},
+    {0x1F7E0, 0x1F7EB}, {0x1F90C, 0x1F9FF}, {0x1FA70, 0x1FAFF}, {0x20000, 0x2FFFD},
+    {0x30000, 0x3FFFD},
+};
+
+template <size_t N>
+constexpr bool inRanges(const CodepointRange (&table)[N], char32_t c) {
+    auto it = std::upper_bound(table, table + N, c,
+                               [](char32_t value, const CodepointRange& range) { return value < range.first; });
+    return it != table && c <= (it - 1)->last;
+}
+
+constexpr size_t codepointWidth(char32_t c) {
+    if (c < 0x20 || (c >= 0x7F && c < 0xA0)) return 0;
+    if (c < 0x300) return 1;
+    if (inRanges(ZERO_WIDTH, c)) return 0;
+    return inRanges(DOUBLE_WIDTH, c) ? 2 : 1;
+}
+
+// Length of the escape sequence at s[0] == '\033': CSI (ESC [ ... final
+// byte), OSC/DCS/APC strings ending in BEL or ESC \, else ESC plus one byte
+constexpr size_t escapeLength(std::string_view s) {
+    if (s.size() < 2) return s.size();
+    size_t i = 2;
+    if (s[1] == '[') {
+        while (i < s.size() && !(s[i] >= 0x40 && s[i] <= 0x7E)) i++;
+        return std::min(i + 1, s.size());
+    }
+    if (s[1] == ']' || s[1] == 'P' || s[1] == '_') {
+        for (; i < s.size(); i++) {
+            if (s[i] == '\a') return i + 1;
+            if (s[i] == '\033' && i + 1 < s.size() && s[i + 1] == '\\') return i + 2;
+        }
+        return s.size();
+    }
+    return 2;
+}
+
+// Columns s occupies on a terminal: UTF-8 decoded, escape sequences and
+// control characters take none, invalid bytes one each. Runs of printable
+// ASCII are counted 16 bytes at a time.
+constexpr size_t displayWidth(std::string_view s) {
+    size_t width = 0;
+    size_t i = 0;
+    while (i < s.size()) {
+#if defined(__SSE2__)
+        if !consteval {
+            // Bytes below 0x20 and above 0x7F are both negative after
+            // subtracting 0x20 with a signed compare, DEL is tested apart
+            const __m128i space = _mm_set1_epi8(0x20);
+            const __m128i del = _mm_set1_epi8(0x7F);
+            while (i + 16 <= s.size()) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.data() + i));
+                unsigned mask = _mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmplt_epi8(chunk, space), _mm_cmpeq_epi8(chunk, del)));
+                if (mask) {
+                    unsigned ascii = __builtin_ctz(mask);
+                    width += ascii;
+                    i += ascii;
+                    break;
+                }
+                width += 16;
+                i += 16;
+            }
+            if (i >= s.size()) break;
+        }
+#endif
+        unsigned char c = s[i];
+        if (c == '\033') {
+            i += escapeLength(s.substr(i));
+            continue;
+        }
+        if (c < 0x80) {
+            width += codepointWidth(c);
+            i++;
+            continue;
+        }
+
+        size_t length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        char32_t cp = length == 4 ? c & 0x07 : length == 3 ? c & 0x0F : c & 0x1F;
+        bool valid = length > 1 && i + length <= s.size();
+        for (size_t k = 1; valid && k < length; k++) {
+            unsigned char next = s[i + k];
+            valid = (next & 0xC0) == 0x80;
+            cp = cp << 6 | (next & 0x3F);
+        }
+        if (!valid) {
+            width++;
+            i++;
+            continue;
+        }
+        width += codepointWidth(cp);
+        i += length;
+    }
+    return width;
+}
+
+static_assert(displayWidth("abc") == 3);
+static_assert(displayWidth("\033[1;31mab\033[0m") == 2);
+static_assert(displayWidth("╔═╗") == 3);
+static_assert(displayWidth("日本") == 4);
+static_assert(displayWidth("é") == 1);
+
+} // namespace kfetch
+
+#endif // WIDTH_H